@@ -22,6 +22,10 @@
 #define JUCE_PYTHON_INCLUDE_PYBIND11_OPERATORS
 #include "../utilities/PyBind11Includes.h"
 
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
 namespace popsicle::Bindings {
 
 using namespace juce;
@@ -31,287 +35,2434 @@ using namespace pybind11::literals;
 
 // ============================================================================================
 
-template <template <class> class Class, class... Types>
-void registerAudioBuffer (py::module_& m)
+namespace {
+
+struct AudioBufferExportedShape
 {
-    py::dict type;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+};
 
-    ([&]
-    {
-        using ValueType = Types;
-        using T = Class<ValueType>;
+struct AudioBufferInstanceState
+{
+    int numExportedBuffers = 0;
+    py::object referencedData;
+};
 
-        const auto className = popsicle::Helpers::pythonizeCompoundClassName ("AudioBuffer", typeid (Types).name());
+std::unordered_map<PyObject*, AudioBufferInstanceState>& getAudioBufferInstanceStates()
+{
+    // Intentionally leaked, the states hold python references that can't be released after finalization
+    static auto* states = new std::unordered_map<PyObject*, AudioBufferInstanceState>();
+    return *states;
+}
 
-        auto class_ = py::class_<T> (m, className.toRawUTF8(), py::buffer_protocol())
-            .def (py::init<>())
-            .def (py::init<int, int>(), "numChannels"_a, "numSamples"_a)
-        //.def (py::init ([](py::buffer dataToReferTo, int numChannelsToUse, int startSample, int numSamples) {})
-            .def ("getNumChannels", &T::getNumChannels)
-            .def ("getNumSamples", &T::getNumSamples)
-            .def ("getReadPointer", [](const T& self, int channelNumber)
-            {
-                return PyArrayView<const ValueType> (self.getReadPointer (channelNumber), static_cast<size_t> (self.getNumSamples()));
-            }, "channelNumber"_a)
-            .def ("getReadPointer", [](const T& self, int channelNumber, int sampleIndex)
-            {
-                return PyArrayView<const ValueType> (self.getReadPointer (channelNumber, sampleIndex), static_cast<size_t> (self.getNumSamples() - sampleIndex));
-            }, "channelNumber"_a, "sampleIndex"_a)
-            .def ("getWritePointer", [](T& self, int channelNumber)
-            {
-                return PyArrayView<ValueType> (self.getWritePointer (channelNumber), static_cast<size_t> (self.getNumSamples()));
-            }, "channelNumber"_a)
-            .def ("getWritePointer", [](T& self, int channelNumber, int sampleIndex)
-            {
-                return PyArrayView<ValueType> (self.getWritePointer (channelNumber, sampleIndex), static_cast<size_t> (self.getNumSamples() - sampleIndex));
-            }, "channelNumber"_a, "sampleIndex"_a)
-            .def ("getArrayOfReadPointers", [](const T& self)
-            {
-                py::list result (self.getNumChannels());
+AudioBufferInstanceState* findAudioBufferInstanceState (py::handle instance)
+{
+    auto& states = getAudioBufferInstanceStates();
 
-                auto pointersArray = self.getArrayOfReadPointers();
-                for (size_t i = 0; i < static_cast<size_t> (self.getNumChannels()); ++i)
-                    result[i] = PyArrayView<const ValueType> (pointersArray[i], static_cast<size_t> (self.getNumSamples()));
+    auto it = states.find (instance.ptr());
+    return it != states.end() ? &it->second : nullptr;
+}
 
-                return result;
-            })
-            .def ("getArrayOfWritePointers", [](T& self)
-            {
-                py::list result (self.getNumChannels());
+AudioBufferInstanceState& getAudioBufferInstanceState (py::handle instance)
+{
+    auto [it, inserted] = getAudioBufferInstanceStates().try_emplace (instance.ptr());
 
-                auto pointersArray = self.getArrayOfWritePointers();
-                for (size_t i = 0; i < static_cast<size_t> (self.getNumChannels()); ++i)
-                    result[i] = PyArrayView<ValueType> (pointersArray[i], static_cast<size_t> (self.getNumSamples()));
+    if (inserted)
+    {
+        py::cpp_function cleanup ([key = instance.ptr()](py::handle weakref)
+        {
+            auto& states = getAudioBufferInstanceStates();
 
-                return result;
-            })
-            .def ("setSize", &T::setSize,
-                "newNumChannels"_a, "newNumSamples"_a, "keepExistingContent"_a = false, "clearExtraSpace"_a = false, "avoidReallocating"_a = false)
-        //.def ("setDataToReferTo", py::overload_cast<ValueType* const*, int, int, int> (&T::setDataToReferTo))
-        //.def ("setDataToReferTo", py::overload_cast<ValueType* const*, int, int> (&T::setDataToReferTo))
-            .def ("makeCopyOf", &T::template makeCopyOf<ValueType>, "other"_a, "avoidReallocating"_a = false)
-            .def ("clear", py::overload_cast<> (&T::clear))
-            .def ("clear", py::overload_cast<int, int> (&T::clear), "startSample"_a, "numSamples"_a)
-            .def ("clear", py::overload_cast<int, int, int> (&T::clear), "channel"_a, "startSample"_a, "numSamples"_a)
-            .def ("hasBeenCleared", &T::hasBeenCleared)
-            .def ("setNotClear", &T::setNotClear)
-            .def ("getSample", &T::getSample, "channel"_a, "sampleIndex"_a)
-            .def ("setSample", &T::setSample, "destChannel"_a, "destSample"_a, "newValue"_a)
-            .def ("addSample", &T::addSample, "destChannel"_a, "destSample"_a, "valueToAdd"_a)
-            .def ("applyGain", py::overload_cast<int, int, int, ValueType> (&T::applyGain), "channel"_a, "startSample"_a, "numSamples"_a, "gain"_a)
-            .def ("applyGain", py::overload_cast<int, int, ValueType> (&T::applyGain), "startSample"_a, "numSamples"_a, "gain"_a)
-            .def ("applyGain", py::overload_cast<ValueType> (&T::applyGain), "gain"_a)
-            .def ("applyGainRamp", py::overload_cast<int, int, int, ValueType, ValueType> (&T::applyGainRamp), "channel"_a, "startSample"_a, "numSamples"_a, "startGain"_a, "endGain"_a)
-            .def ("applyGainRamp", py::overload_cast<int, int, ValueType, ValueType> (&T::applyGainRamp), "startSample"_a, "numSamples"_a, "startGain"_a, "endGain"_a)
-            .def ("addFrom", py::overload_cast<int, int, const T&, int, int, int, ValueType> (&T::addFrom),
-                "destChannel"_a, "destStartSample"_a, "source"_a, "sourceChannel"_a, "sourceStartSample"_a, "numSamples"_a, "gainToApplyToSource"_a = ValueType (1))
-        //.def ("addFrom", py::overload_cast<int, int, const ValueType*, int, ValueType> (&T::addFrom))
-        //.def ("addFromWithRamp", &T::addFromWithRamp)
-            .def ("copyFrom", py::overload_cast<int, int, const T&, int, int, int> (&T::copyFrom),
-                "destChannel"_a, "destStartSample"_a, "source"_a, "sourceChannel"_a, "sourceStartSample"_a, "numSamples"_a)
-        //.def ("copyFrom", py::overload_cast<int, int, const ValueType*, int> (&T::copyFrom))
-        //.def ("copyFrom", py::overload_cast<int, int, const ValueType*, int, ValueType> (&T::copyFrom))
-        //.def ("copyFromWithRamp", &T::copyFromWithRamp)
-            .def ("findMinMax", &T::findMinMax, "channel"_a, "startSample"_a, "numSamples"_a)
-            .def ("getMagnitude", py::overload_cast<int, int, int> (&T::getMagnitude, py::const_), "channel"_a, "startSample"_a, "numSamples"_a)
-            .def ("getMagnitude", py::overload_cast<int, int> (&T::getMagnitude, py::const_), "startSample"_a, "numSamples"_a)
-            .def ("getRMSLevel", &T::getRMSLevel, "channel"_a, "startSample"_a, "numSamples"_a)
-            .def ("reverse", py::overload_cast<int, int, int> (&T::reverse, py::const_), "channel"_a, "startSample"_a, "numSamples"_a)
-            .def ("reverse", py::overload_cast<int, int> (&T::reverse, py::const_), "startSample"_a, "numSamples"_a)
-            .def (py::self == py::self)
-            .def (py::self != py::self)
-            .def ("__repr__", [](const T& self)
+            if (auto found = states.find (key); found != states.end())
             {
-                String result;
-                result
-                    << Helpers::pythonizeModuleClassName (PythonModuleName, typeid (self).name())
-                    << "(" << self.getNumChannels() << ", " << self.getNumSamples() << ")";
-                return result;
-            })
-        ;
+                // Releasing the referenced data can collect other buffers, so it's dropped after erasing
+                auto state = std::move (found->second);
+                states.erase (found);
+            }
 
-        type[py::type::of (py::cast (Types{}))] = class_;
+            weakref.dec_ref();
+        });
 
-        return true;
-    }() && ...);
+        py::weakref (instance, cleanup).release();
+    }
 
-    m.add_object ("AudioBuffer", type);
+    return it->second;
+}
+
+template <class T>
+py::object getAudioBufferInstance (T& self)
+{
+    return py::cast (self, py::return_value_policy::reference);
+}
+
+template <class T>
+void checkAudioBufferIsNotExported (T& self)
+{
+    if (auto state = findAudioBufferInstanceState (getAudioBufferInstance (self)); state != nullptr && state->numExportedBuffers > 0)
+        throw py::buffer_error ("AudioBuffer data is exported to other objects, release them before resizing or reassigning it");
+}
+
+template <class T>
+void setAudioBufferReferencedData (T& self, py::object dataToReferTo)
+{
+    // Only the latest referenced data needs to outlive the buffer, the previous one is released here
+    auto previousData = std::exchange (getAudioBufferInstanceState (getAudioBufferInstance (self)).referencedData, std::move (dataToReferTo));
+}
+
+template <class T, class ValueType>
+int getAudioBufferExportedBuffer (PyObject* obj, Py_buffer* view, int flags)
+{
+    if (view == nullptr)
+    {
+        PyErr_SetString (PyExc_BufferError, "Invalid buffer view requested");
+        return -1;
+    }
+
+    std::memset (view, 0, sizeof (Py_buffer));
+
+    py::detail::make_caster<T> caster;
+    if (! caster.load (obj, false))
+    {
+        PyErr_SetString (PyExc_BufferError, "Unable to access the AudioBuffer instance");
+        return -1;
+    }
+
+    T& self = py::detail::cast_op<T&> (caster);
+
+    const auto numChannels = self.getNumChannels();
+    const auto numSamples = self.getNumSamples();
+    const auto channelStride = getChannelStride (self);
+
+    if (! channelStride.has_value())
+    {
+        PyErr_SetString (PyExc_BufferError,
+            "AudioBuffer channels are not laid out with a uniform stride, access them with getWritePointer instead");
+        return -1;
+    }
+
+    const bool isContiguous = numChannels <= 1 || *channelStride == numSamples;
+    const bool wantsContiguous = (flags & PyBUF_STRIDES) != PyBUF_STRIDES
+        || (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS
+        || (flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS
+        || (flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS;
+
+    if (! isContiguous && wantsContiguous)
+    {
+        PyErr_SetString (PyExc_BufferError, "AudioBuffer channels are not contiguous, a strided buffer must be requested");
+        return -1;
+    }
+
+    // Exporting gives python write access to the samples, so the buffer can't be considered clear anymore
+    static ValueType emptyStorage {};
+    ValueType* data = numChannels > 0 ? self.getArrayOfWritePointers()[0] : &emptyStorage;
+
+    auto exportedShape = std::make_unique<AudioBufferExportedShape>();
+    exportedShape->shape[0] = static_cast<Py_ssize_t> (numChannels);
+    exportedShape->shape[1] = static_cast<Py_ssize_t> (numSamples);
+    exportedShape->strides[0] = static_cast<Py_ssize_t> (*channelStride) * static_cast<Py_ssize_t> (sizeof (ValueType));
+    exportedShape->strides[1] = static_cast<Py_ssize_t> (sizeof (ValueType));
+
+    view->obj = obj;
+    view->buf = data;
+    view->itemsize = static_cast<Py_ssize_t> (sizeof (ValueType));
+    view->len = exportedShape->shape[0] * exportedShape->shape[1] * view->itemsize;
+    view->readonly = 0;
+    view->ndim = 2;
+
+    if ((flags & PyBUF_FORMAT) == PyBUF_FORMAT)
+        view->format = const_cast<char*> (py::format_descriptor<ValueType>::value);
+
+    if ((flags & PyBUF_ND) == PyBUF_ND)
+        view->shape = exportedShape->shape;
+
+    if ((flags & PyBUF_STRIDES) == PyBUF_STRIDES)
+        view->strides = exportedShape->strides;
+
+    try
+    {
+        getAudioBufferInstanceState (obj).numExportedBuffers += 1;
+    }
+    catch (py::error_already_set& e)
+    {
+        e.restore();
+        return -1;
+    }
+
+    view->internal = exportedShape.release();
+
+    Py_INCREF (view->obj);
+    return 0;
+}
+
+void releaseAudioBufferExportedBuffer (PyObject* obj, Py_buffer* view)
+{
+    delete static_cast<AudioBufferExportedShape*> (view->internal);
+
+    if (auto state = findAudioBufferInstanceState (obj))
+        state->numExportedBuffers -= 1;
+}
+
+template <class T, class ValueType>
+void installAudioBufferProtocol (py::class_<T>& class_)
+{
+    // pybind11 can't report errors from inside def_buffer, so the slots are installed directly
+    auto heapType = reinterpret_cast<PyHeapTypeObject*> (class_.ptr());
+    heapType->as_buffer.bf_getbuffer = &getAudioBufferExportedBuffer<T, ValueType>;
+    heapType->as_buffer.bf_releasebuffer = &releaseAudioBufferExportedBuffer;
 }
 
 // ============================================================================================
 
-void registerJuceAudioBasicsBindings (py::module_& m)
+template <class ValueType>
+struct ChannelsToReferTo
 {
-    // ============================================================================================ juce::FloatArrayView
+    std::vector<ValueType*> channels;
+    int numSamples = 0;
+
+    int getNumChannels() const noexcept
+    {
+        return static_cast<int> (channels.size());
+    }
+
+    void checkRange (int numChannelsToUse, int startSample, int numSamplesToUse) const
+    {
+        if (numChannelsToUse <= 0 || numChannelsToUse > getNumChannels())
+            py::pybind11_fail ("Invalid number of channels to refer to");
+
+        if (startSample < 0 || numSamplesToUse < 0 || startSample + numSamplesToUse > numSamples)
+            py::pybind11_fail ("Out of bound access of buffer data");
+    }
+};
+
+template <class ValueType>
+ChannelsToReferTo<ValueType> getChannelsToReferTo (const py::buffer& dataToReferTo)
+{
+    auto info = dataToReferTo.request (true);
+
+    ChannelsToReferTo<ValueType> result;
+    result.channels = getBufferChannelPointers<ValueType> (info, result.numSamples);
+
+    if (result.channels.empty())
+        py::pybind11_fail ("Buffer to refer to must contain at least one channel");
+
+    return result;
+}
+
+// ============================================================================================
+
+template <class F>
+void callReleasingGILForLargeSpans (size_t numValues, F&& func)
+{
+    if (numValues >= minimumValuesToReleaseGIL)
+    {
+        py::gil_scoped_release release;
+        func();
+    }
+    else
+    {
+        func();
+    }
+}
+
+template <class T>
+Range<size_t> getArrayViewSliceRange (const PyArrayView<T>& self, const py::slice& slice)
+{
+    size_t start = 0, stop = 0, step = 0, sliceLength = 0;
+    if (! slice.compute (self.size(), &start, &stop, &step, &sliceLength))
+        throw py::error_already_set();
+
+    if (step != 1 && sliceLength > 1)
+        py::pybind11_fail ("Only contiguous slices of array data are supported");
+
+    return Range<size_t>::withStartAndLength (start, sliceLength);
+}
+
+template <class ValueType>
+const ValueType* getArrayViewSourceValues (const py::buffer_info& info, size_t expectedSize)
+{
+    if (! isBufferOfType<ValueType> (info))
+        py::pybind11_fail ("Buffer data type doesn't match the array data type");
+
+    if (info.ndim != 1 || (info.size > 1 && info.strides[0] != static_cast<py::ssize_t> (sizeof (ValueType))))
+        py::pybind11_fail ("Buffer must be one dimensional and contiguous");
+
+    if (static_cast<size_t> (info.size) != expectedSize)
+        py::pybind11_fail ("Buffer size doesn't match the array data size");
 
-    py::class_<PyArrayView<const float>> classConstFloatArrayView (m, "ConstFloatArrayView", py::buffer_protocol());
+    return static_cast<const ValueType*> (info.ptr);
+}
+
+template <class ValueType>
+std::optional<ValueType> getArrayViewScalarValue (const py::buffer& values, const py::buffer_info& info)
+{
+    // NumPy scalars expose zero dimensional buffers, they behave like plain python numbers
+    if (info.ndim != 0)
+        return std::nullopt;
+
+    return values.cast<ValueType>();
+}
+
+template <class T>
+void registerArrayView (py::module_& m, const char* className)
+{
+    using ValueType = std::remove_const_t<T>;
+    using View = PyArrayView<T>;
+
+    py::class_<View> class_ (m, className, py::buffer_protocol());
 
-    classConstFloatArrayView
-        .def ("__getitem__", [](PyArrayView<const float>& self, size_t index)
+    class_
+        .def ("__getitem__", [](View& self, size_t index)
         {
             if (self.data() == nullptr || index >= self.size())
-                pybind11::pybind11_fail ("Out of bound access of array data");
+                py::pybind11_fail ("Out of bound access of array data");
 
             return *(self.data() + index);
         })
-        .def ("__len__", &PyArrayView<const float>::size)
-        .def ("__iter__", [](PyArrayView<const float>& self)
+        .def ("__getitem__", [](View& self, py::slice slice)
+        {
+            const auto range = getArrayViewSliceRange (self, slice);
+            return View (self.data() + range.getStart(), range.getLength());
+        }, py::keep_alive<0, 1>())
+        .def ("__len__", &View::size)
+        .def ("__iter__", [](View& self)
         {
             if (self.data() == nullptr)
-                pybind11::pybind11_fail ("Invalid empty array");
+                py::pybind11_fail ("Invalid empty array");
 
             return py::make_iterator (self.data(), self.data() + self.size());
         })
-        .def_buffer ([](PyArrayView<const float>& self) -> py::buffer_info
+        .def_buffer ([](View& self) -> py::buffer_info
         {
-            return py::buffer_info (self.data(), static_cast<ssize_t> (self.size()), true);
+            return py::buffer_info (self.data(), static_cast<ssize_t> (self.size()), std::is_const_v<T>);
         })
     ;
 
-    py::class_<PyArrayView<float>> classFloatArrayView (m, "FloatArrayView", py::buffer_protocol());
+    if constexpr (! std::is_const_v<T>)
+    {
+        class_
+            .def ("__setitem__", [](View& self, size_t index, ValueType value)
+            {
+                if (index >= self.size())
+                    py::pybind11_fail ("Out of bound access of channel data");
+
+                *(self.data() + index) = value;
+            })
+            .def ("__setitem__", [](View& self, py::slice slice, ValueType value)
+            {
+                const auto range = getArrayViewSliceRange (self, slice);
+
+                callReleasingGILForLargeSpans (range.getLength(), [&]
+                {
+                    std::fill_n (self.data() + range.getStart(), range.getLength(), value);
+                });
+            })
+            .def ("__setitem__", [](View& self, py::slice slice, py::buffer values)
+            {
+                const auto range = getArrayViewSliceRange (self, slice);
+                const auto info = values.request();
+
+                if (const auto value = getArrayViewScalarValue<ValueType> (values, info))
+                {
+                    callReleasingGILForLargeSpans (range.getLength(), [&]
+                    {
+                        std::fill_n (self.data() + range.getStart(), range.getLength(), *value);
+                    });
+
+                    return;
+                }
+
+                const auto source = getArrayViewSourceValues<ValueType> (info, range.getLength());
+
+                callReleasingGILForLargeSpans (range.getLength(), [&]
+                {
+                    std::memmove (self.data() + range.getStart(), source, range.getLength() * sizeof (ValueType));
+                });
+            })
+        ;
+    }
+
+    if constexpr (! std::is_const_v<T> && std::is_floating_point_v<ValueType>)
+    {
+        const auto applyScalar = [](auto operation)
+        {
+            return [operation](View& self, ValueType value) -> View&
+            {
+                callReleasingGILForLargeSpans (self.size(), [&]
+                {
+                    operation (self.data(), value, static_cast<int> (self.size()));
+                });
+
+                return self;
+            };
+        };
+
+        const auto applyBuffer = [](auto scalarOperation, auto operation)
+        {
+            return [scalarOperation, operation](View& self, py::buffer values) -> View&
+            {
+                const auto info = values.request();
+
+                if (const auto value = getArrayViewScalarValue<ValueType> (values, info))
+                {
+                    callReleasingGILForLargeSpans (self.size(), [&]
+                    {
+                        scalarOperation (self.data(), *value, static_cast<int> (self.size()));
+                    });
+
+                    return self;
+                }
+
+                const auto source = getArrayViewSourceValues<ValueType> (info, self.size());
+
+                callReleasingGILForLargeSpans (self.size(), [&]
+                {
+                    operation (self.data(), source, static_cast<int> (self.size()));
+                });
+
+                return self;
+            };
+        };
+
+        const auto addScalar = [](ValueType* dest, ValueType value, int num)
+        {
+            FloatVectorOperations::add (dest, value, num);
+        };
+
+        const auto subtractScalar = [](ValueType* dest, ValueType value, int num)
+        {
+            FloatVectorOperations::add (dest, -value, num);
+        };
+
+        const auto multiplyScalar = [](ValueType* dest, ValueType value, int num)
+        {
+            FloatVectorOperations::multiply (dest, value, num);
+        };
+
+        class_
+            .def ("fill", [](View& self, ValueType valueToFill)
+            {
+                callReleasingGILForLargeSpans (self.size(), [&]
+                {
+                    FloatVectorOperations::fill (self.data(), valueToFill, static_cast<int> (self.size()));
+                });
+            }, "valueToFill"_a)
+            .def ("clear", [](View& self)
+            {
+                callReleasingGILForLargeSpans (self.size(), [&]
+                {
+                    FloatVectorOperations::clear (self.data(), static_cast<int> (self.size()));
+                });
+            })
+            .def ("clip", [](View& self, ValueType low, ValueType high)
+            {
+                callReleasingGILForLargeSpans (self.size(), [&]
+                {
+                    FloatVectorOperations::clip (self.data(), self.data(), low, high, static_cast<int> (self.size()));
+                });
+            }, "low"_a, "high"_a)
+            .def ("negate", [](View& self)
+            {
+                callReleasingGILForLargeSpans (self.size(), [&]
+                {
+                    FloatVectorOperations::negate (self.data(), self.data(), static_cast<int> (self.size()));
+                });
+            })
+            .def ("__iadd__", applyScalar (addScalar), py::return_value_policy::reference)
+            .def ("__iadd__", applyBuffer (addScalar, [](ValueType* dest, const ValueType* source, int num)
+            {
+                FloatVectorOperations::add (dest, source, num);
+            }), py::return_value_policy::reference)
+            .def ("__isub__", applyScalar (subtractScalar), py::return_value_policy::reference)
+            .def ("__isub__", applyBuffer (subtractScalar, [](ValueType* dest, const ValueType* source, int num)
+            {
+                FloatVectorOperations::subtract (dest, source, num);
+            }), py::return_value_policy::reference)
+            .def ("__imul__", applyScalar (multiplyScalar), py::return_value_policy::reference)
+            .def ("__imul__", applyBuffer (multiplyScalar, [](ValueType* dest, const ValueType* source, int num)
+            {
+                FloatVectorOperations::multiply (dest, source, num);
+            }), py::return_value_policy::reference)
+        ;
+    }
+}
+
+} // namespace
+
+// ============================================================================================
+
+template <class ValueType>
+const ValueType* getAudioBufferSourceSamples (const py::buffer_info& info, int numSamples)
+{
+    if (! isBufferOfType<ValueType> (info))
+        py::pybind11_fail ("Buffer data type doesn't match the expected sample type");
+
+    if (info.ndim != 1 || (info.size > 1 && info.strides[0] != static_cast<py::ssize_t> (sizeof (ValueType))))
+        py::pybind11_fail ("Source buffer must be one dimensional and contiguous");
+
+    if (numSamples < 0 || info.size < static_cast<py::ssize_t> (numSamples))
+        py::pybind11_fail ("Source buffer doesn't contain enough samples");
+
+    return static_cast<const ValueType*> (info.ptr);
+}
+
+template <class T>
+void checkAudioBufferRegion (const T& buffer, int channel, int startSample, int numSamples)
+{
+    if (! isPositiveAndBelow (channel, buffer.getNumChannels()))
+        py::pybind11_fail ("Channel index is out of range");
+
+    if (startSample < 0 || numSamples < 0 || static_cast<int64> (startSample) + numSamples > buffer.getNumSamples())
+        py::pybind11_fail ("Out of bound access of buffer data");
+}
+
+template <class T, class ValueType, class F>
+void processAudioBufferFromSource (T& self, int destChannel, int destStartSample, const py::buffer& source, int numSamples, F&& func)
+{
+    const auto info = source.request();
+    const auto samples = getAudioBufferSourceSamples<ValueType> (info, numSamples);
+    checkAudioBufferRegion (self, destChannel, destStartSample, numSamples);
+
+    callReleasingGILForLargeSpans (static_cast<size_t> (numSamples), [&] { func (samples); });
+}
+
+// ============================================================================================
+
+struct PCMConverters
+{
+    using ToFloat = void (*) (const void*, float*, int);
+    using FromFloat = void (*) (const float*, void*, int);
+    using ToInt32 = void (*) (const void*, int32*, int);
+    using FromInt32 = void (*) (const int32*, void*, int);
+    using Interleave = void (*) (const AudioBuffer<float>&, int, int, void*);
+    using Deinterleave = void (*) (const void*, AudioBuffer<float>&, int, int);
+
+    int bytesPerSample = 0;
+    bool isFloatingPoint = false;
+    ToFloat toFloat = nullptr;
+    FromFloat fromFloat = nullptr;
+    ToInt32 toInt32 = nullptr;
+    FromInt32 fromInt32 = nullptr;
+    Interleave interleave = nullptr;
+    Deinterleave deinterleave = nullptr;
+};
+
+template <class DataFormat, class Endianness>
+struct PCMConvertersFor
+{
+    using NativeFloatPointer = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+    using NativeConstFloatPointer = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
+    using NativeInt32Pointer = AudioData::Pointer<AudioData::Int32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+    using NativeConstInt32Pointer = AudioData::Pointer<AudioData::Int32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
+
+    static void toFloat (const void* source, float* dest, int numSamples) noexcept
+    {
+        using SourcePointer = AudioData::Pointer<DataFormat, Endianness, AudioData::NonInterleaved, AudioData::Const>;
+        NativeFloatPointer (dest).convertSamples (SourcePointer (source), numSamples);
+    }
+
+    static void fromFloat (const float* source, void* dest, int numSamples) noexcept
+    {
+        using DestPointer = AudioData::Pointer<DataFormat, Endianness, AudioData::NonInterleaved, AudioData::NonConst>;
+        DestPointer (dest).convertSamples (NativeConstFloatPointer (source), numSamples);
+    }
+
+    static void toInt32 (const void* source, int32* dest, int numSamples) noexcept
+    {
+        using SourcePointer = AudioData::Pointer<DataFormat, Endianness, AudioData::NonInterleaved, AudioData::Const>;
+        NativeInt32Pointer (dest).convertSamples (SourcePointer (source), numSamples);
+    }
+
+    static void fromInt32 (const int32* source, void* dest, int numSamples) noexcept
+    {
+        using DestPointer = AudioData::Pointer<DataFormat, Endianness, AudioData::NonInterleaved, AudioData::NonConst>;
+        DestPointer (dest).convertSamples (NativeConstInt32Pointer (source), numSamples);
+    }
+
+    static void interleave (const AudioBuffer<float>& source, int startSample, int numSamples, void* dest) noexcept
+    {
+        using DestPointer = AudioData::Pointer<DataFormat, Endianness, AudioData::Interleaved, AudioData::NonConst>;
+
+        const auto numChannels = source.getNumChannels();
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            DestPointer (static_cast<char*> (dest) + channel * DataFormat::bytesPerSample, numChannels)
+                .convertSamples (NativeConstFloatPointer (source.getReadPointer (channel, startSample)), numSamples);
+        }
+    }
+
+    static void deinterleave (const void* source, AudioBuffer<float>& dest, int startSample, int numSamples) noexcept
+    {
+        using SourcePointer = AudioData::Pointer<DataFormat, Endianness, AudioData::Interleaved, AudioData::Const>;
+
+        const auto numChannels = dest.getNumChannels();
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            NativeFloatPointer (dest.getWritePointer (channel, startSample))
+                .convertSamples (SourcePointer (static_cast<const char*> (source) + channel * DataFormat::bytesPerSample, numChannels), numSamples);
+        }
+    }
+
+    static PCMConverters get() noexcept
+    {
+        return { DataFormat::bytesPerSample, DataFormat::isFloat != 0, &toFloat, &fromFloat, &toInt32, &fromInt32, &interleave, &deinterleave };
+    }
+};
+
+template <class DataFormat>
+PCMConverters getPCMConverters (PCMEndianness endianness) noexcept
+{
+    if (endianness == PCMEndianness::bigEndian)
+        return PCMConvertersFor<DataFormat, AudioData::BigEndian>::get();
+
+    return PCMConvertersFor<DataFormat, AudioData::LittleEndian>::get();
+}
+
+PCMConverters getPCMConverters (PCMSampleFormat format, PCMEndianness endianness)
+{
+    switch (format)
+    {
+        case PCMSampleFormat::int8:     return getPCMConverters<AudioData::Int8> (endianness);
+        case PCMSampleFormat::uint8:    return getPCMConverters<AudioData::UInt8> (endianness);
+        case PCMSampleFormat::int16:    return getPCMConverters<AudioData::Int16> (endianness);
+        case PCMSampleFormat::int24:    return getPCMConverters<AudioData::Int24> (endianness);
+        case PCMSampleFormat::int32:    return getPCMConverters<AudioData::Int32> (endianness);
+        case PCMSampleFormat::float32:  return getPCMConverters<AudioData::Float32> (endianness);
+        default: break;
+    }
+
+    py::pybind11_fail ("Unsupported PCM sample format");
+}
+
+py::buffer_info getContiguousBufferInfo (const py::buffer& buffer, bool writable)
+{
+    auto info = buffer.request (writable);
+
+    if (! PyBuffer_IsContiguous (info.view(), 'C'))
+        py::pybind11_fail ("PCM buffer must be contiguous");
+
+    return info;
+}
+
+size_t getBufferSizeInBytes (const py::buffer_info& info) noexcept
+{
+    return static_cast<size_t> (info.size) * static_cast<size_t> (info.itemsize);
+}
+
+int getPCMNumSamples (int startSample, int numSamples, int bufferNumSamples, size_t numFramesInData)
+{
+    if (startSample < 0 || startSample > bufferNumSamples)
+        py::pybind11_fail ("Out of bound access of buffer data");
+
+    if (numSamples < 0)
+        numSamples = static_cast<int> (jmin (static_cast<size_t> (bufferNumSamples - startSample), numFramesInData));
+
+    if (startSample + numSamples > bufferNumSamples)
+        py::pybind11_fail ("Out of bound access of buffer data");
+
+    if (static_cast<size_t> (numSamples) > numFramesInData)
+        py::pybind11_fail ("PCM buffer doesn't contain enough samples");
+
+    return numSamples;
+}
+
+int interleaveAudioBuffer (const AudioBuffer<float>& source, py::buffer dest, PCMSampleFormat format, PCMEndianness endianness, int startSample, int numSamples)
+{
+    const auto converters = getPCMConverters (format, endianness);
+    const auto info = getContiguousBufferInfo (dest, true);
+
+    const auto frameSize = static_cast<size_t> (jmax (1, source.getNumChannels()) * converters.bytesPerSample);
+    numSamples = getPCMNumSamples (startSample, numSamples, source.getNumSamples(), getBufferSizeInBytes (info) / frameSize);
+
+    callReleasingGILForLargeSpans (static_cast<size_t> (numSamples * source.getNumChannels()), [&]
+    {
+        converters.interleave (source, startSample, numSamples, info.ptr);
+    });
+
+    return numSamples;
+}
+
+int deinterleaveAudioBuffer (py::buffer source, AudioBuffer<float>& dest, PCMSampleFormat format, PCMEndianness endianness, int startSample, int numSamples)
+{
+    const auto converters = getPCMConverters (format, endianness);
+    const auto info = getContiguousBufferInfo (source, false);
+
+    const auto frameSize = static_cast<size_t> (jmax (1, dest.getNumChannels()) * converters.bytesPerSample);
+    numSamples = getPCMNumSamples (startSample, numSamples, dest.getNumSamples(), getBufferSizeInBytes (info) / frameSize);
+
+    callReleasingGILForLargeSpans (static_cast<size_t> (numSamples * dest.getNumChannels()), [&]
+    {
+        converters.deinterleave (info.ptr, dest, startSample, numSamples);
+    });
+
+    return numSamples;
+}
+
+size_t convertPCMSamples (py::buffer source, PCMSampleFormat sourceFormat, PCMEndianness sourceEndianness,
+                          py::buffer dest, PCMSampleFormat destFormat, PCMEndianness destEndianness,
+                          py::ssize_t numSamples)
+{
+    const auto sourceConverters = getPCMConverters (sourceFormat, sourceEndianness);
+    const auto destConverters = getPCMConverters (destFormat, destEndianness);
+
+    const auto sourceInfo = getContiguousBufferInfo (source, false);
+    const auto destInfo = getContiguousBufferInfo (dest, true);
+
+    const auto numSourceSamples = getBufferSizeInBytes (sourceInfo) / static_cast<size_t> (sourceConverters.bytesPerSample);
+    const auto numDestSamples = getBufferSizeInBytes (destInfo) / static_cast<size_t> (destConverters.bytesPerSample);
+
+    const auto numSamplesToConvert = numSamples < 0 ? numSourceSamples : static_cast<size_t> (numSamples);
+    if (numSamplesToConvert > numSourceSamples)
+        py::pybind11_fail ("Source PCM buffer doesn't contain enough samples");
+
+    if (numSamplesToConvert > numDestSamples)
+        py::pybind11_fail ("Destination PCM buffer is too small");
+
+    // Integer pairs go through left aligned int32 samples, so byte order swaps and widening are lossless
+    const auto isIntegerConversion = ! sourceConverters.isFloatingPoint && ! destConverters.isFloatingPoint;
+
+    callReleasingGILForLargeSpans (numSamplesToConvert, [&]
+    {
+        constexpr size_t blockSize = 1024;
+        float floatBlock[blockSize];
+        int32 intBlock[blockSize];
+
+        auto sourceData = static_cast<const char*> (sourceInfo.ptr);
+        auto destData = static_cast<char*> (destInfo.ptr);
+
+        for (size_t offset = 0; offset < numSamplesToConvert; offset += blockSize)
+        {
+            const auto numThisTime = static_cast<int> (jmin (blockSize, numSamplesToConvert - offset));
+            const auto sourceSamples = sourceData + offset * static_cast<size_t> (sourceConverters.bytesPerSample);
+            const auto destSamples = destData + offset * static_cast<size_t> (destConverters.bytesPerSample);
+
+            if (isIntegerConversion)
+            {
+                sourceConverters.toInt32 (sourceSamples, intBlock, numThisTime);
+                destConverters.fromInt32 (intBlock, destSamples, numThisTime);
+            }
+            else
+            {
+                sourceConverters.toFloat (sourceSamples, floatBlock, numThisTime);
+                destConverters.fromFloat (floatBlock, destSamples, numThisTime);
+            }
+        }
+    });
+
+    return numSamplesToConvert;
+}
+
+// ============================================================================================
+
+template <template <class> class Class, class... Types>
+void registerAudioBuffer (py::module_& m)
+{
+    py::dict type;
+
+    ([&]
+    {
+        using ValueType = Types;
+        using T = Class<ValueType>;
+
+        const auto className = popsicle::Helpers::pythonizeCompoundClassName ("AudioBuffer", typeid (Types).name());
+
+        auto class_ = py::class_<T> (m, className.toRawUTF8(), py::buffer_protocol())
+            .def (py::init<>())
+            .def (py::init<int, int>(), "numChannels"_a, "numSamples"_a)
+            .def (py::init ([](py::buffer dataToReferTo)
+            {
+                const auto data = getChannelsToReferTo<ValueType> (dataToReferTo);
+                return T (data.channels.data(), data.getNumChannels(), data.numSamples);
+            }), "dataToReferTo"_a, py::keep_alive<1, 2>())
+            .def (py::init ([](py::buffer dataToReferTo, int numChannelsToUse, int startSample, int numSamples)
+            {
+                const auto data = getChannelsToReferTo<ValueType> (dataToReferTo);
+                data.checkRange (numChannelsToUse, startSample, numSamples);
+                return T (data.channels.data(), numChannelsToUse, startSample, numSamples);
+            }), "dataToReferTo"_a, "numChannelsToUse"_a, "startSample"_a, "numSamples"_a, py::keep_alive<1, 2>())
+            .def_static ("referTo", [](py::buffer dataToReferTo)
+            {
+                const auto data = getChannelsToReferTo<ValueType> (dataToReferTo);
+                return T (data.channels.data(), data.getNumChannels(), data.numSamples);
+            }, "dataToReferTo"_a, py::keep_alive<0, 1>())
+            .def ("getNumChannels", &T::getNumChannels)
+            .def ("getNumSamples", &T::getNumSamples)
+            .def ("getReadPointer", [](const T& self, int channelNumber)
+            {
+                return PyArrayView<const ValueType> (self.getReadPointer (channelNumber), static_cast<size_t> (self.getNumSamples()));
+            }, "channelNumber"_a)
+            .def ("getReadPointer", [](const T& self, int channelNumber, int sampleIndex)
+            {
+                return PyArrayView<const ValueType> (self.getReadPointer (channelNumber, sampleIndex), static_cast<size_t> (self.getNumSamples() - sampleIndex));
+            }, "channelNumber"_a, "sampleIndex"_a)
+            .def ("getWritePointer", [](T& self, int channelNumber)
+            {
+                return PyArrayView<ValueType> (self.getWritePointer (channelNumber), static_cast<size_t> (self.getNumSamples()));
+            }, "channelNumber"_a)
+            .def ("getWritePointer", [](T& self, int channelNumber, int sampleIndex)
+            {
+                return PyArrayView<ValueType> (self.getWritePointer (channelNumber, sampleIndex), static_cast<size_t> (self.getNumSamples() - sampleIndex));
+            }, "channelNumber"_a, "sampleIndex"_a)
+            .def ("getArrayOfReadPointers", [](const T& self)
+            {
+                py::list result (self.getNumChannels());
+
+                auto pointersArray = self.getArrayOfReadPointers();
+                for (size_t i = 0; i < static_cast<size_t> (self.getNumChannels()); ++i)
+                    result[i] = PyArrayView<const ValueType> (pointersArray[i], static_cast<size_t> (self.getNumSamples()));
+
+                return result;
+            })
+            .def ("getArrayOfWritePointers", [](T& self)
+            {
+                py::list result (self.getNumChannels());
+
+                auto pointersArray = self.getArrayOfWritePointers();
+                for (size_t i = 0; i < static_cast<size_t> (self.getNumChannels()); ++i)
+                    result[i] = PyArrayView<ValueType> (pointersArray[i], static_cast<size_t> (self.getNumSamples()));
+
+                return result;
+            })
+            .def ("setSize", [](T& self, int newNumChannels, int newNumSamples, bool keepExistingContent, bool clearExtraSpace, bool avoidReallocating)
+            {
+                checkAudioBufferIsNotExported (self);
+                self.setSize (newNumChannels, newNumSamples, keepExistingContent, clearExtraSpace, avoidReallocating);
+            }, "newNumChannels"_a, "newNumSamples"_a, "keepExistingContent"_a = false, "clearExtraSpace"_a = false, "avoidReallocating"_a = false)
+            .def ("setDataToReferTo", [](T& self, py::buffer dataToReferTo, int newNumChannels, int newStartSample, int newNumSamples)
+            {
+                checkAudioBufferIsNotExported (self);
+                const auto data = getChannelsToReferTo<ValueType> (dataToReferTo);
+                data.checkRange (newNumChannels, newStartSample, newNumSamples);
+                self.setDataToReferTo (data.channels.data(), newNumChannels, newStartSample, newNumSamples);
+                setAudioBufferReferencedData (self, std::move (dataToReferTo));
+            }, "dataToReferTo"_a, "newNumChannels"_a, "newStartSample"_a, "newNumSamples"_a)
+            .def ("setDataToReferTo", [](T& self, py::buffer dataToReferTo, int newNumChannels, int newNumSamples)
+            {
+                checkAudioBufferIsNotExported (self);
+                const auto data = getChannelsToReferTo<ValueType> (dataToReferTo);
+                data.checkRange (newNumChannels, 0, newNumSamples);
+                self.setDataToReferTo (data.channels.data(), newNumChannels, newNumSamples);
+                setAudioBufferReferencedData (self, std::move (dataToReferTo));
+            }, "dataToReferTo"_a, "newNumChannels"_a, "newNumSamples"_a)
+            .def ("setDataToReferTo", [](T& self, py::buffer dataToReferTo)
+            {
+                checkAudioBufferIsNotExported (self);
+                const auto data = getChannelsToReferTo<ValueType> (dataToReferTo);
+                self.setDataToReferTo (data.channels.data(), data.getNumChannels(), data.numSamples);
+                setAudioBufferReferencedData (self, std::move (dataToReferTo));
+            }, "dataToReferTo"_a)
+            .def ("makeCopyOf", [](T& self, const T& other, bool avoidReallocating)
+            {
+                checkAudioBufferIsNotExported (self);
+                self.makeCopyOf (other, avoidReallocating);
+            }, "other"_a, "avoidReallocating"_a = false)
+            .def ("clear", py::overload_cast<> (&T::clear))
+            .def ("clear", py::overload_cast<int, int> (&T::clear), "startSample"_a, "numSamples"_a)
+            .def ("clear", py::overload_cast<int, int, int> (&T::clear), "channel"_a, "startSample"_a, "numSamples"_a)
+            .def ("hasBeenCleared", &T::hasBeenCleared)
+            .def ("setNotClear", &T::setNotClear)
+            .def ("getSample", &T::getSample, "channel"_a, "sampleIndex"_a)
+            .def ("setSample", &T::setSample, "destChannel"_a, "destSample"_a, "newValue"_a)
+            .def ("addSample", &T::addSample, "destChannel"_a, "destSample"_a, "valueToAdd"_a)
+            .def ("applyGain", py::overload_cast<int, int, int, ValueType> (&T::applyGain), "channel"_a, "startSample"_a, "numSamples"_a, "gain"_a)
+            .def ("applyGain", py::overload_cast<int, int, ValueType> (&T::applyGain), "startSample"_a, "numSamples"_a, "gain"_a)
+            .def ("applyGain", py::overload_cast<ValueType> (&T::applyGain), "gain"_a)
+            .def ("applyGainRamp", py::overload_cast<int, int, int, ValueType, ValueType> (&T::applyGainRamp), "channel"_a, "startSample"_a, "numSamples"_a, "startGain"_a, "endGain"_a)
+            .def ("applyGainRamp", py::overload_cast<int, int, ValueType, ValueType> (&T::applyGainRamp), "startSample"_a, "numSamples"_a, "startGain"_a, "endGain"_a)
+            .def ("addFrom", py::overload_cast<int, int, const T&, int, int, int, ValueType> (&T::addFrom),
+                "destChannel"_a, "destStartSample"_a, "source"_a, "sourceChannel"_a, "sourceStartSample"_a, "numSamples"_a, "gainToApplyToSource"_a = ValueType (1))
+            .def ("addFrom", [](T& self, int destChannel, int destStartSample, py::buffer source, int numSamples, ValueType gainToApplyToSource)
+            {
+                processAudioBufferFromSource<T, ValueType> (self, destChannel, destStartSample, source, numSamples, [&](const ValueType* samples)
+                {
+                    self.addFrom (destChannel, destStartSample, samples, numSamples, gainToApplyToSource);
+                });
+            }, "destChannel"_a, "destStartSample"_a, "source"_a, "numSamples"_a, "gainToApplyToSource"_a = ValueType (1))
+            .def ("addFromWithRamp", [](T& self, int destChannel, int destStartSample, py::buffer source, int numSamples, ValueType startGain, ValueType endGain)
+            {
+                processAudioBufferFromSource<T, ValueType> (self, destChannel, destStartSample, source, numSamples, [&](const ValueType* samples)
+                {
+                    self.addFromWithRamp (destChannel, destStartSample, samples, numSamples, startGain, endGain);
+                });
+            }, "destChannel"_a, "destStartSample"_a, "source"_a, "numSamples"_a, "startGain"_a, "endGain"_a)
+            .def ("copyFrom", py::overload_cast<int, int, const T&, int, int, int> (&T::copyFrom),
+                "destChannel"_a, "destStartSample"_a, "source"_a, "sourceChannel"_a, "sourceStartSample"_a, "numSamples"_a)
+            .def ("copyFrom", [](T& self, int destChannel, int destStartSample, py::buffer source, int numSamples)
+            {
+                processAudioBufferFromSource<T, ValueType> (self, destChannel, destStartSample, source, numSamples, [&](const ValueType* samples)
+                {
+                    self.copyFrom (destChannel, destStartSample, samples, numSamples);
+                });
+            }, "destChannel"_a, "destStartSample"_a, "source"_a, "numSamples"_a)
+            .def ("copyFrom", [](T& self, int destChannel, int destStartSample, py::buffer source, int numSamples, ValueType gain)
+            {
+                processAudioBufferFromSource<T, ValueType> (self, destChannel, destStartSample, source, numSamples, [&](const ValueType* samples)
+                {
+                    self.copyFrom (destChannel, destStartSample, samples, numSamples, gain);
+                });
+            }, "destChannel"_a, "destStartSample"_a, "source"_a, "numSamples"_a, "gain"_a)
+            .def ("copyFromWithRamp", [](T& self, int destChannel, int destStartSample, py::buffer source, int numSamples, ValueType startGain, ValueType endGain)
+            {
+                processAudioBufferFromSource<T, ValueType> (self, destChannel, destStartSample, source, numSamples, [&](const ValueType* samples)
+                {
+                    self.copyFromWithRamp (destChannel, destStartSample, samples, numSamples, startGain, endGain);
+                });
+            }, "destChannel"_a, "destStartSample"_a, "source"_a, "numSamples"_a, "startGain"_a, "endGain"_a)
+            .def ("findMinMax", &T::findMinMax, "channel"_a, "startSample"_a, "numSamples"_a)
+            .def ("getMagnitude", py::overload_cast<int, int, int> (&T::getMagnitude, py::const_), "channel"_a, "startSample"_a, "numSamples"_a)
+            .def ("getMagnitude", py::overload_cast<int, int> (&T::getMagnitude, py::const_), "startSample"_a, "numSamples"_a)
+            .def ("getRMSLevel", &T::getRMSLevel, "channel"_a, "startSample"_a, "numSamples"_a)
+            .def ("reverse", py::overload_cast<int, int, int> (&T::reverse, py::const_), "channel"_a, "startSample"_a, "numSamples"_a)
+            .def ("reverse", py::overload_cast<int, int> (&T::reverse, py::const_), "startSample"_a, "numSamples"_a)
+            .def (py::self == py::self)
+            .def (py::self != py::self)
+            .def ("__repr__", [](const T& self)
+            {
+                String result;
+                result
+                    << Helpers::pythonizeModuleClassName (PythonModuleName, typeid (self).name())
+                    << "(" << self.getNumChannels() << ", " << self.getNumSamples() << ")";
+                return result;
+            })
+        ;
+
+        installAudioBufferProtocol<T, ValueType> (class_);
+
+        type[py::type::of (py::cast (Types{}))] = class_;
+
+        return true;
+    }() && ...);
+
+    m.add_object ("AudioBuffer", type);
+}
+
+// ============================================================================================
+
+template <class ValueType>
+class PyAudioBufferPool
+{
+public:
+    PyAudioBufferPool() = default;
+
+    ~PyAudioBufferPool()
+    {
+        releaseViews();
+    }
+
+    void prepare (int numBuffers, int newNumChannels, int newNumSamples, py::object viewFactory)
+    {
+        if (numBuffers < 0 || newNumChannels < 0 || newNumSamples < 0)
+            py::pybind11_fail ("Invalid audio buffer pool size");
+
+        if (slots.getNumInUse() > 0)
+            py::pybind11_fail ("Unable to prepare the audio buffer pool while buffers are in use");
+
+        std::vector<Entry> newEntries;
+        newEntries.reserve (static_cast<size_t> (numBuffers));
+
+        for (int index = 0; index < numBuffers; ++index)
+        {
+            auto bufferObject = py::cast (AudioBuffer<ValueType> (newNumChannels, newNumSamples));
+            bufferObject.template cast<AudioBuffer<ValueType>&>().clear();
+
+            auto viewObject = viewFactory.is_none()
+                ? py::object (py::memoryview (bufferObject))
+                : viewFactory (bufferObject);
+
+            newEntries.push_back ({ std::move (bufferObject), std::move (viewObject) });
+        }
+
+        releaseViews();
+
+        entries = std::move (newEntries);
+        numChannels = newNumChannels;
+        numSamples = newNumSamples;
+
+        slots.prepare (numBuffers);
+    }
+
+    py::object acquire()
+    {
+        const auto index = slots.acquire();
+        return index >= 0 ? entries[static_cast<size_t> (index)].buffer : py::object (py::none());
+    }
+
+    py::object acquireView()
+    {
+        const auto index = slots.acquire();
+        return index >= 0 ? entries[static_cast<size_t> (index)].view : py::object (py::none());
+    }
+
+    void release (const py::object& bufferOrView)
+    {
+        if (! slots.release (getIndexOf (bufferOrView)))
+            py::pybind11_fail ("Buffer has already been released to the pool");
+    }
+
+    py::object getView (const py::object& bufferOrView) const
+    {
+        return entries[static_cast<size_t> (getIndexOf (bufferOrView))].view;
+    }
+
+    py::object getBuffer (const py::object& bufferOrView) const
+    {
+        return entries[static_cast<size_t> (getIndexOf (bufferOrView))].buffer;
+    }
+
+    bool owns (const py::object& bufferOrView) const
+    {
+        return findIndexOf (bufferOrView) >= 0;
+    }
+
+    int getNumChannels() const noexcept { return numChannels; }
+    int getNumSamples() const noexcept { return numSamples; }
+
+    const PoolSlotAllocator& getSlots() const noexcept { return slots; }
+    PoolSlotAllocator& getSlots() noexcept { return slots; }
+
+private:
+    struct Entry
+    {
+        py::object buffer;
+        py::object view;
+    };
+
+    int findIndexOf (const py::object& bufferOrView) const
+    {
+        for (size_t index = 0; index < entries.size(); ++index)
+        {
+            if (entries[index].buffer.is (bufferOrView) || entries[index].view.is (bufferOrView))
+                return static_cast<int> (index);
+        }
+
+        return -1;
+    }
+
+    int getIndexOf (const py::object& bufferOrView) const
+    {
+        const auto index = findIndexOf (bufferOrView);
+        if (index < 0)
+            py::pybind11_fail ("Buffer doesn't belong to the pool");
+
+        return index;
+    }
+
+    void releaseViews()
+    {
+        // Make sure stale views can't access buffers that are not handed out by the pool anymore
+        for (auto& entry : entries)
+        {
+            if (! py::isinstance<py::memoryview> (entry.view))
+                continue;
+
+            try
+            {
+                entry.view.attr ("release")();
+            }
+            catch (const py::error_already_set&)
+            {
+            }
+        }
+    }
+
+    std::vector<Entry> entries;
+    PoolSlotAllocator slots;
+    int numChannels = 0;
+    int numSamples = 0;
+};
+
+template <class... Types>
+void registerAudioBufferPool (py::module_& m)
+{
+    ([&]
+    {
+        using ValueType = Types;
+        using T = PyAudioBufferPool<ValueType>;
+
+        const auto className = popsicle::Helpers::pythonizeCompoundClassName ("AudioBufferPool", typeid (Types).name());
+
+        py::class_<T> (m, className.toRawUTF8())
+            .def (py::init<>())
+            .def (py::init ([](int numBuffers, int numChannels, int numSamples, py::object viewFactory)
+            {
+                auto result = std::make_unique<T>();
+                result->prepare (numBuffers, numChannels, numSamples, std::move (viewFactory));
+                return result;
+            }), "numBuffers"_a, "numChannels"_a, "numSamples"_a, "viewFactory"_a = py::none())
+            .def ("prepare", &T::prepare, "numBuffers"_a, "numChannels"_a, "numSamples"_a, "viewFactory"_a = py::none())
+            .def ("acquire", &T::acquire)
+            .def ("acquireView", &T::acquireView)
+            .def ("release", &T::release, "bufferOrView"_a)
+            .def ("getView", &T::getView, "bufferOrView"_a)
+            .def ("getBuffer", &T::getBuffer, "bufferOrView"_a)
+            .def ("owns", &T::owns, "bufferOrView"_a)
+            .def ("getNumBuffers", [](const T& self) { return self.getSlots().getNumSlots(); })
+            .def ("getNumChannels", &T::getNumChannels)
+            .def ("getNumSamples", &T::getNumSamples)
+            .def ("getNumAvailable", [](const T& self) { return self.getSlots().getNumAvailable(); })
+            .def ("getNumInUse", [](const T& self) { return self.getSlots().getNumInUse(); })
+            .def ("getHighWaterMark", [](const T& self) { return self.getSlots().getHighWaterMark(); })
+            .def ("getNumFailedAcquires", [](const T& self) { return self.getSlots().getNumFailedAcquires(); })
+            .def ("resetStatistics", [](T& self) { self.getSlots().resetStatistics(); })
+        ;
+
+        return true;
+    }() && ...);
+}
+
+// ============================================================================================
+
+struct AudioFifoRegion
+{
+    py::object owner;
+    float* data = nullptr;
+    int numChannels = 0;
+    int numSamples = 0;
+    int channelStride = 0;
+    bool readOnly = true;
+};
+
+py::tuple getAudioFifoRegions (AudioFifo& fifo, py::object owner, int startIndex1, int blockSize1, int startIndex2, int blockSize2, bool readOnly)
+{
+    const auto makeRegion = [&](int startIndex, int blockSize)
+    {
+        return AudioFifoRegion { owner, fifo.getChannelData (0, startIndex), fifo.getNumChannels(), blockSize, fifo.getChannelStride(), readOnly };
+    };
+
+    return py::make_tuple (makeRegion (startIndex1, blockSize1), makeRegion (startIndex2, blockSize2));
+}
+
+template <class T>
+std::vector<T*> getChannelBufferListPointers (const py::list& channelBuffers, std::vector<py::buffer_info>& infos, int& numSamples)
+{
+    std::vector<T*> channels;
+    channels.reserve (channelBuffers.size());
+    infos.reserve (channelBuffers.size());
+
+    for (const auto& channelBuffer : channelBuffers)
+    {
+        infos.push_back (channelBuffer.cast<py::buffer>().request (! std::is_const_v<T>));
+
+        int numChannelSamples = 0;
+        const auto channelPointers = getBufferChannelPointers<T> (infos.back(), numChannelSamples);
+        if (channelPointers.size() != 1)
+            py::pybind11_fail ("Each channel buffer must be one dimensional");
+
+        if (! channels.empty() && numChannelSamples != numSamples)
+            py::pybind11_fail ("All the channel buffers must have the same size");
+
+        numSamples = numChannelSamples;
+        channels.push_back (channelPointers.front());
+    }
+
+    return channels;
+}
+
+// ============================================================================================
+
+enum class AudioSourceGraphParameter
+{
+    frequency,
+    amplitude,
+    ratio,
+    gain,
+    q,
+    roomSize,
+    damping,
+    wetLevel,
+    dryLevel,
+    width,
+    freezeMode
+};
+
+std::optional<AudioSourceGraphParameter> getAudioSourceGraphParameter (StringRef name)
+{
+    static const std::pair<const char*, AudioSourceGraphParameter> parameters[] =
+    {
+        { "frequency", AudioSourceGraphParameter::frequency },
+        { "amplitude", AudioSourceGraphParameter::amplitude },
+        { "ratio", AudioSourceGraphParameter::ratio },
+        { "gain", AudioSourceGraphParameter::gain },
+        { "q", AudioSourceGraphParameter::q },
+        { "roomSize", AudioSourceGraphParameter::roomSize },
+        { "damping", AudioSourceGraphParameter::damping },
+        { "wetLevel", AudioSourceGraphParameter::wetLevel },
+        { "dryLevel", AudioSourceGraphParameter::dryLevel },
+        { "width", AudioSourceGraphParameter::width },
+        { "freezeMode", AudioSourceGraphParameter::freezeMode }
+    };
+
+    for (const auto& [parameterName, parameter] : parameters)
+    {
+        if (name == StringRef (parameterName))
+            return parameter;
+    }
+
+    return std::nullopt;
+}
+
+template <class T>
+T getGraphNodeProperty (const py::dict& description, const char* name, T defaultValue)
+{
+    return description.contains (name) ? description[name].template cast<T>() : defaultValue;
+}
+
+struct AudioSourceGraphNode
+{
+    virtual ~AudioSourceGraphNode() = default;
+
+    virtual AudioSource& getAudioSource() = 0;
+
+    virtual bool hasParameter (AudioSourceGraphParameter) const { return false; }
+    virtual void setParameter (AudioSourceGraphParameter, double) {}
+
+    String id;
+};
+
+struct ToneGeneratorGraphNode : ToneGeneratorAudioSource, AudioSourceGraphNode
+{
+    AudioSource& getAudioSource() override { return *this; }
+
+    bool hasParameter (AudioSourceGraphParameter parameter) const override
+    {
+        return parameter == AudioSourceGraphParameter::frequency
+            || parameter == AudioSourceGraphParameter::amplitude;
+    }
+
+    void setParameter (AudioSourceGraphParameter parameter, double value) override
+    {
+        if (parameter == AudioSourceGraphParameter::frequency)
+            setFrequency (value);
+        else if (parameter == AudioSourceGraphParameter::amplitude)
+            setAmplitude (static_cast<float> (value));
+    }
+};
+
+struct MixerGraphNode : MixerAudioSource, AudioSourceGraphNode
+{
+    AudioSource& getAudioSource() override { return *this; }
+};
+
+struct ResamplingGraphNode : ResamplingAudioSource, AudioSourceGraphNode
+{
+    ResamplingGraphNode (AudioSource& input, int numChannels)
+        : ResamplingAudioSource (&input, false, numChannels)
+    {
+    }
+
+    AudioSource& getAudioSource() override { return *this; }
+
+    bool hasParameter (AudioSourceGraphParameter parameter) const override
+    {
+        return parameter == AudioSourceGraphParameter::ratio;
+    }
+
+    void setParameter (AudioSourceGraphParameter parameter, double value) override
+    {
+        if (parameter == AudioSourceGraphParameter::ratio)
+            setResamplingRatio (value);
+    }
+};
+
+struct ChannelRemappingGraphNode : ChannelRemappingAudioSource, AudioSourceGraphNode
+{
+    explicit ChannelRemappingGraphNode (AudioSource& input)
+        : ChannelRemappingAudioSource (&input, false)
+    {
+    }
+
+    AudioSource& getAudioSource() override { return *this; }
+};
+
+struct IIRFilterGraphNode : IIRFilterAudioSource, AudioSourceGraphNode
+{
+    enum class Shape
+    {
+        lowPass,
+        highPass,
+        bandPass,
+        notch,
+        lowShelf,
+        highShelf,
+        peak
+    };
+
+    IIRFilterGraphNode (AudioSource& input, Shape shape)
+        : IIRFilterAudioSource (&input, false)
+        , shape (shape)
+    {
+    }
+
+    AudioSource& getAudioSource() override { return *this; }
+
+    void prepareToPlay (int samplesPerBlockExpected, double newSampleRate) override
+    {
+        sampleRate = newSampleRate;
+        updateCoefficients();
+
+        IIRFilterAudioSource::prepareToPlay (samplesPerBlockExpected, newSampleRate);
+    }
+
+    bool hasParameter (AudioSourceGraphParameter parameter) const override
+    {
+        return parameter == AudioSourceGraphParameter::frequency
+            || parameter == AudioSourceGraphParameter::q
+            || parameter == AudioSourceGraphParameter::gain;
+    }
+
+    void setParameter (AudioSourceGraphParameter parameter, double value) override
+    {
+        if (parameter == AudioSourceGraphParameter::frequency)
+            frequency = value;
+        else if (parameter == AudioSourceGraphParameter::q)
+            q = value;
+        else if (parameter == AudioSourceGraphParameter::gain)
+            gain = value;
+
+        updateCoefficients();
+    }
+
+    static std::optional<Shape> getShape (StringRef name)
+    {
+        if (name == StringRef ("lowPass"))   return Shape::lowPass;
+        if (name == StringRef ("highPass"))  return Shape::highPass;
+        if (name == StringRef ("bandPass"))  return Shape::bandPass;
+        if (name == StringRef ("notch"))     return Shape::notch;
+        if (name == StringRef ("lowShelf"))  return Shape::lowShelf;
+        if (name == StringRef ("highShelf")) return Shape::highShelf;
+        if (name == StringRef ("peak"))      return Shape::peak;
+        return std::nullopt;
+    }
+
+    double frequency = 1000.0;
+    double q = 1.0 / MathConstants<double>::sqrt2;
+    double gain = 1.0;
+
+private:
+    void updateCoefficients()
+    {
+        if (sampleRate <= 0.0)
+            return;
+
+        const auto limitedFrequency = jlimit (1.0, sampleRate * 0.49, frequency);
+        const auto limitedQ = jmax (0.01, q);
+        const auto limitedGain = static_cast<float> (jmax (0.0001, gain));
+
+        switch (shape)
+        {
+            case Shape::lowPass:   setCoefficients (IIRCoefficients::makeLowPass (sampleRate, limitedFrequency, limitedQ)); break;
+            case Shape::highPass:  setCoefficients (IIRCoefficients::makeHighPass (sampleRate, limitedFrequency, limitedQ)); break;
+            case Shape::bandPass:  setCoefficients (IIRCoefficients::makeBandPass (sampleRate, limitedFrequency, limitedQ)); break;
+            case Shape::notch:     setCoefficients (IIRCoefficients::makeNotchFilter (sampleRate, limitedFrequency, limitedQ)); break;
+            case Shape::lowShelf:  setCoefficients (IIRCoefficients::makeLowShelf (sampleRate, limitedFrequency, limitedQ, limitedGain)); break;
+            case Shape::highShelf: setCoefficients (IIRCoefficients::makeHighShelf (sampleRate, limitedFrequency, limitedQ, limitedGain)); break;
+            case Shape::peak:      setCoefficients (IIRCoefficients::makePeakFilter (sampleRate, limitedFrequency, limitedQ, limitedGain)); break;
+            default: break;
+        }
+    }
+
+    Shape shape;
+    double sampleRate = 0.0;
+};
+
+struct ReverbGraphNode : ReverbAudioSource, AudioSourceGraphNode
+{
+    explicit ReverbGraphNode (AudioSource& input)
+        : ReverbAudioSource (&input, false)
+    {
+    }
+
+    AudioSource& getAudioSource() override { return *this; }
+
+    bool hasParameter (AudioSourceGraphParameter parameter) const override
+    {
+        Reverb::Parameters values;
+        return getParameterValue (values, parameter) != nullptr;
+    }
+
+    void setParameter (AudioSourceGraphParameter parameter, double value) override
+    {
+        if (auto parameterValue = getParameterValue (parameters, parameter))
+        {
+            *parameterValue = static_cast<float> (value);
+            setParameters (parameters);
+        }
+    }
+
+    static float* getParameterValue (Reverb::Parameters& values, AudioSourceGraphParameter parameter) noexcept
+    {
+        switch (parameter)
+        {
+            case AudioSourceGraphParameter::roomSize:   return &values.roomSize;
+            case AudioSourceGraphParameter::damping:    return &values.damping;
+            case AudioSourceGraphParameter::wetLevel:   return &values.wetLevel;
+            case AudioSourceGraphParameter::dryLevel:   return &values.dryLevel;
+            case AudioSourceGraphParameter::width:      return &values.width;
+            case AudioSourceGraphParameter::freezeMode: return &values.freezeMode;
+            default: break;
+        }
+
+        return nullptr;
+    }
+
+    Reverb::Parameters parameters;
+};
+
+struct GainGraphNode : AudioSource, AudioSourceGraphNode
+{
+    GainGraphNode (AudioSource& input, float initialGain)
+        : input (input)
+        , currentGain (initialGain)
+        , targetGain (initialGain)
+    {
+    }
+
+    AudioSource& getAudioSource() override { return *this; }
+
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override
+    {
+        currentGain = targetGain;
+        input.prepareToPlay (samplesPerBlockExpected, sampleRate);
+    }
+
+    void releaseResources() override
+    {
+        input.releaseResources();
+    }
+
+    void getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill) override
+    {
+        input.getNextAudioBlock (bufferToFill);
+
+        if (approximatelyEqual (currentGain, targetGain))
+            bufferToFill.buffer->applyGain (bufferToFill.startSample, bufferToFill.numSamples, targetGain);
+        else
+            bufferToFill.buffer->applyGainRamp (bufferToFill.startSample, bufferToFill.numSamples, currentGain, targetGain);
+
+        currentGain = targetGain;
+    }
+
+    bool hasParameter (AudioSourceGraphParameter parameter) const override
+    {
+        return parameter == AudioSourceGraphParameter::gain;
+    }
+
+    void setParameter (AudioSourceGraphParameter parameter, double value) override
+    {
+        if (parameter == AudioSourceGraphParameter::gain)
+            targetGain = static_cast<float> (value);
+    }
+
+private:
+    AudioSource& input;
+    float currentGain = 1.0f;
+    float targetGain = 1.0f;
+};
+
+struct MeterGraphNode : AudioSource, AudioSourceGraphNode
+{
+    MeterGraphNode (AudioSource& input, LevelMeterBank& meter)
+        : input (input)
+        , meter (meter)
+    {
+    }
+
+    AudioSource& getAudioSource() override { return *this; }
+
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override
+    {
+        input.prepareToPlay (samplesPerBlockExpected, sampleRate);
+    }
+
+    void releaseResources() override
+    {
+        input.releaseResources();
+    }
+
+    void getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill) override
+    {
+        input.getNextAudioBlock (bufferToFill);
+        meter.process (*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+    }
+
+private:
+    AudioSource& input;
+    LevelMeterBank& meter;
+};
+
+struct ExternalGraphNode : AudioSourceGraphNode
+{
+    explicit ExternalGraphNode (AudioSource& source)
+        : source (source)
+    {
+    }
+
+    AudioSource& getAudioSource() override { return source; }
+
+private:
+    AudioSource& source;
+};
+
+/**
+ * @brief An AudioSource chain built from a python description that never calls back into python while rendering.
+ *
+ * Nodes are described by dicts with a "type", an optional "id" and the node properties, with "input" (or "inputs" for
+ * mixers) holding the upstream nodes. Parameters are changed through a lock-free command queue that is drained by the
+ * audio thread at the start of each block.
+ *
+ * Nodes of type "source" only accept instances of native classes, but the inputs of native wrappers such as
+ * AudioTransportSource, MixerAudioSource or ResamplingAudioSource are private to JUCE and can't be inspected: if one of
+ * those wraps a python source, rendering will still acquire the GIL to call it.
+ */
+class AudioSourceGraph : public AudioSource
+{
+public:
+    AudioSourceGraph (const py::dict& description, int maxPendingCommands)
+        : commandFifo (jmax (1, maxPendingCommands) + 1)
+        , commands (static_cast<size_t> (commandFifo.getTotalSize()))
+    {
+        try
+        {
+            rootNode = &createNode (description);
+        }
+        catch (...)
+        {
+            clearNodes();
+            throw;
+        }
+    }
+
+    ~AudioSourceGraph() override
+    {
+        clearNodes();
+    }
+
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override
+    {
+        applyPendingCommands();
+
+        rootNode->getAudioSource().prepareToPlay (samplesPerBlockExpected, sampleRate);
+    }
+
+    void releaseResources() override
+    {
+        rootNode->getAudioSource().releaseResources();
+    }
+
+    void getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill) override
+    {
+        applyPendingCommands();
+
+        rootNode->getAudioSource().getNextAudioBlock (bufferToFill);
+    }
+
+    bool setParameter (const String& nodeId, const String& parameterName, double value)
+    {
+        const auto parameter = getAudioSourceGraphParameter (parameterName);
+        if (! parameter)
+            py::pybind11_fail ("Unknown audio source graph parameter");
+
+        const auto nodeIndex = getNodeIndex (nodeId);
+        if (! nodes[static_cast<size_t> (nodeIndex)]->hasParameter (*parameter))
+            py::pybind11_fail ("Audio source graph node doesn't have the requested parameter");
+
+        const auto scope = commandFifo.write (1);
+        if (scope.blockSize1 + scope.blockSize2 == 0)
+        {
+            numDroppedCommands.fetch_add (1, std::memory_order_relaxed);
+            return false;
+        }
+
+        commands[static_cast<size_t> (scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)] = { nodeIndex, *parameter, value };
+        return true;
+    }
+
+    py::list getNodeIds() const
+    {
+        py::list result;
+
+        for (const auto& node : nodes)
+        {
+            if (node->id.isNotEmpty())
+                result.append (node->id);
+        }
+
+        return result;
+    }
+
+    bool hasNode (const String& nodeId) const
+    {
+        return findNodeIndex (nodeId) >= 0;
+    }
+
+    int getNumNodes() const noexcept
+    {
+        return static_cast<int> (nodes.size());
+    }
+
+    int getNumPendingCommands() const noexcept
+    {
+        return commandFifo.getNumReady();
+    }
+
+    int64 getNumDroppedCommands() const noexcept
+    {
+        return numDroppedCommands.load (std::memory_order_relaxed);
+    }
+
+private:
+    struct Command
+    {
+        int nodeIndex = -1;
+        AudioSourceGraphParameter parameter = AudioSourceGraphParameter::gain;
+        double value = 0.0;
+    };
+
+    void clearNodes()
+    {
+        // Upstream nodes are created first, so deleting in reverse order never leaves dangling inputs
+        for (auto it = nodes.rbegin(); it != nodes.rend(); ++it)
+            it->reset();
+
+        nodes.clear();
+    }
+
+    void applyPendingCommands() noexcept
+    {
+        const auto scope = commandFifo.read (commandFifo.getNumReady());
+
+        scope.forEach ([this](int index)
+        {
+            const auto& command = commands[static_cast<size_t> (index)];
+            nodes[static_cast<size_t> (command.nodeIndex)]->setParameter (command.parameter, command.value);
+        });
+    }
+
+    int findNodeIndex (const String& nodeId) const
+    {
+        for (size_t index = 0; index < nodes.size(); ++index)
+        {
+            if (nodes[index]->id == nodeId)
+                return static_cast<int> (index);
+        }
+
+        return -1;
+    }
+
+    int getNodeIndex (const String& nodeId) const
+    {
+        const auto index = nodeId.isNotEmpty() ? findNodeIndex (nodeId) : -1;
+        if (index < 0)
+            py::pybind11_fail ("Audio source graph node not found");
+
+        return index;
+    }
+
+    AudioSource& createInputNode (const py::dict& description)
+    {
+        if (! description.contains ("input"))
+            py::pybind11_fail ("Audio source graph node requires an input");
+
+        return createNode (description["input"].cast<py::dict>()).getAudioSource();
+    }
+
+    AudioSourceGraphNode& createNode (const py::dict& description)
+    {
+        const auto type = getGraphNodeProperty<String> (description, "type", {});
+
+        std::unique_ptr<AudioSourceGraphNode> node;
+
+        if (type == "tone")
+        {
+            auto tone = std::make_unique<ToneGeneratorGraphNode>();
+            tone->setFrequency (getGraphNodeProperty (description, "frequency", 1000.0));
+            tone->setAmplitude (getGraphNodeProperty (description, "amplitude", 0.5f));
+            node = std::move (tone);
+        }
+        else if (type == "mixer")
+        {
+            auto mixer = std::make_unique<MixerGraphNode>();
+
+            if (description.contains ("inputs"))
+            {
+                for (const auto& input : description["inputs"].cast<py::list>())
+                    mixer->addInputSource (&createNode (input.cast<py::dict>()).getAudioSource(), false);
+            }
+
+            node = std::move (mixer);
+        }
+        else if (type == "resampling")
+        {
+            auto& input = createInputNode (description);
+            auto resampling = std::make_unique<ResamplingGraphNode> (input, getGraphNodeProperty (description, "numChannels", 2));
+            resampling->setResamplingRatio (getGraphNodeProperty (description, "ratio", 1.0));
+            node = std::move (resampling);
+        }
+        else if (type == "channelRemapping")
+        {
+            auto& input = createInputNode (description);
+            auto remapping = std::make_unique<ChannelRemappingGraphNode> (input);
+            remapping->setNumberOfChannelsToProduce (getGraphNodeProperty (description, "numChannels", 2));
+
+            int channelIndex = 0;
+            for (const auto& sourceChannel : getGraphNodeProperty (description, "inputMapping", py::list()))
+                remapping->setInputChannelMapping (channelIndex++, sourceChannel.cast<int>());
+
+            channelIndex = 0;
+            for (const auto& destChannel : getGraphNodeProperty (description, "outputMapping", py::list()))
+                remapping->setOutputChannelMapping (channelIndex++, destChannel.cast<int>());
+
+            node = std::move (remapping);
+        }
+        else if (type == "iirFilter")
+        {
+            const auto shape = IIRFilterGraphNode::getShape (getGraphNodeProperty<String> (description, "filter", "lowPass"));
+            if (! shape)
+                py::pybind11_fail ("Unknown audio source graph filter shape");
+
+            auto& input = createInputNode (description);
+            auto filter = std::make_unique<IIRFilterGraphNode> (input, *shape);
+            filter->frequency = getGraphNodeProperty (description, "frequency", filter->frequency);
+            filter->q = getGraphNodeProperty (description, "q", filter->q);
+            filter->gain = getGraphNodeProperty (description, "gain", filter->gain);
+            node = std::move (filter);
+        }
+        else if (type == "reverb")
+        {
+            auto& input = createInputNode (description);
+            auto reverb = std::make_unique<ReverbGraphNode> (input);
+
+            for (const auto name : { "roomSize", "damping", "wetLevel", "dryLevel", "width", "freezeMode" })
+            {
+                if (description.contains (name))
+                    *ReverbGraphNode::getParameterValue (reverb->parameters, *getAudioSourceGraphParameter (name)) = description[name].cast<float>();
+            }
+
+            reverb->setParameters (reverb->parameters);
+            node = std::move (reverb);
+        }
+        else if (type == "gain")
+        {
+            auto& input = createInputNode (description);
+            node = std::make_unique<GainGraphNode> (input, getGraphNodeProperty (description, "gain", 1.0f));
+        }
+        else if (type == "meter")
+        {
+            if (! description.contains ("meter"))
+                py::pybind11_fail ("Audio source graph meter node requires a meter");
+
+            py::object meter = description["meter"];
+
+            auto& input = createInputNode (description);
+            node = std::make_unique<MeterGraphNode> (input, meter.cast<LevelMeterBank&>());
+            externalMeters.push_back (std::move (meter));
+        }
+        else if (type == "source")
+        {
+            if (! description.contains ("source"))
+                py::pybind11_fail ("Audio source graph source node requires a source");
+
+            py::object source = description["source"];
+
+            // Python subclasses would dispatch overrides through the GIL, so only exact native classes are accepted.
+            // This doesn't extend to the sources wrapped by a native source, which JUCE doesn't expose
+            const auto typeInfo = py::detail::get_type_info (Py_TYPE (source.ptr()));
+            if (typeInfo == nullptr || typeInfo->type != Py_TYPE (source.ptr()))
+                py::pybind11_fail ("Audio source graph only accepts native audio sources");
+
+            node = std::make_unique<ExternalGraphNode> (*source.cast<AudioSource*>());
+            externalSources.push_back (std::move (source));
+        }
+        else
+        {
+            py::pybind11_fail ("Unknown audio source graph node type");
+        }
+
+        node->id = getGraphNodeProperty<String> (description, "id", {});
+        if (node->id.isNotEmpty() && findNodeIndex (node->id) >= 0)
+            py::pybind11_fail ("Duplicated audio source graph node id");
+
+        nodes.push_back (std::move (node));
+        return *nodes.back();
+    }
+
+    std::vector<std::unique_ptr<AudioSourceGraphNode>> nodes;
+    std::vector<py::object> externalSources;
+    std::vector<py::object> externalMeters;
+    AudioSourceGraphNode* rootNode = nullptr;
+
+    AbstractFifo commandFifo;
+    std::vector<Command> commands;
+    std::atomic<int64> numDroppedCommands { 0 };
+};
+
+// ============================================================================================
+
+std::vector<float*> getAudioBufferWritePointers (AudioBuffer<float>& buffer)
+{
+    auto channels = buffer.getArrayOfWritePointers();
+    return std::vector<float*> (channels, channels + buffer.getNumChannels());
+}
+
+// ============================================================================================
+
+/**
+ * @brief Renders a source on a dedicated worker thread a fixed number of blocks ahead of the audio thread.
+ *
+ * The audio thread only pulls already rendered samples from a lock-free AudioFifo, so python sources can't cause
+ * dropouts by holding the GIL, at the cost of a fixed latency of numBlocksAhead blocks.
+ */
+class RenderAheadAudioSource : public AudioSource, private Thread
+{
+public:
+    RenderAheadAudioSource (AudioSource* sourceToUse, int numBlocksAhead, int numChannels)
+        : Thread ("RenderAheadAudioSource")
+        , source (sourceToUse)
+        , numBlocksAhead (jmax (1, numBlocksAhead))
+        , numChannels (jmax (1, numChannels))
+    {
+        if (source == nullptr)
+            py::pybind11_fail ("Invalid source to render ahead");
+    }
+
+    ~RenderAheadAudioSource() override
+    {
+        // The worker might be waiting for the GIL to render a python source
+        if (PyGILState_Check())
+        {
+            py::gil_scoped_release release;
+            stopThread (-1);
+        }
+        else
+        {
+            stopThread (-1);
+        }
+    }
+
+    void prepareToPlay (int samplesPerBlockExpected, double newSampleRate) override
+    {
+        stopThread (-1);
+
+        blockSize = jmax (1, samplesPerBlockExpected);
+        sampleRate = newSampleRate;
+
+        fifo = std::make_unique<AudioFifo> (numChannels, numBlocksAhead * blockSize);
+        renderBuffer.setSize (numChannels, blockSize);
+        channelPointers.assign (static_cast<size_t> (numChannels), nullptr);
+        failed.store (false, std::memory_order_relaxed);
+
+        source->prepareToPlay (blockSize, sampleRate);
+
+        renderAvailableBlocks();
+        startThread();
+    }
+
+    void releaseResources() override
+    {
+        stopThread (-1);
+
+        source->releaseResources();
+    }
+
+    void getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill) override
+    {
+        auto buffer = bufferToFill.buffer;
+
+        if (fifo == nullptr)
+        {
+            bufferToFill.clearActiveBufferRegion();
+            return;
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            channelPointers[static_cast<size_t> (channel)] = channel < buffer->getNumChannels()
+                ? buffer->getWritePointer (channel, bufferToFill.startSample)
+                : nullptr;
+        }
+
+        fifo->read (channelPointers.data(), numChannels, bufferToFill.numSamples);
+
+        for (int channel = numChannels; channel < buffer->getNumChannels(); ++channel)
+            buffer->clear (channel, bufferToFill.startSample, bufferToFill.numSamples);
+    }
+
+    int getNumBlocksAhead() const noexcept { return numBlocksAhead; }
+    int getNumChannels() const noexcept { return numChannels; }
+    int getLatencySamples() const noexcept { return numBlocksAhead * blockSize; }
+    double getLatencySeconds() const noexcept { return sampleRate > 0.0 ? getLatencySamples() / sampleRate : 0.0; }
+    int getNumReady() const noexcept { return fifo != nullptr ? fifo->getNumReady() : 0; }
+    int64 getNumUnderruns() const noexcept { return fifo != nullptr ? fifo->getNumUnderruns() : 0; }
+    bool isRendering() const noexcept { return isThreadRunning(); }
+    bool hasFailed() const noexcept { return failed.load (std::memory_order_relaxed); }
+
+private:
+    void run() override
+    {
+        const auto waitMilliseconds = jmax (1, roundToInt (500.0 * blockSize / jmax (1.0, sampleRate)));
+
+        while (! threadShouldExit())
+        {
+            if (! renderAvailableBlocks())
+                return;
+
+            wait (waitMilliseconds);
+        }
+    }
+
+    bool renderAvailableBlocks()
+    {
+        const auto isWorker = Thread::getCurrentThread() == this;
+
+        while (fifo->getFreeSpace() >= blockSize && ! (isWorker && threadShouldExit()))
+        {
+            renderBuffer.clear();
+
+            try
+            {
+                source->getNextAudioBlock (AudioSourceChannelInfo (renderBuffer));
+            }
+            catch (const std::exception&)
+            {
+                failed.store (true, std::memory_order_relaxed);
+                return false;
+            }
+
+            fifo->write (renderBuffer.getArrayOfReadPointers(), numChannels, blockSize);
+        }
+
+        return true;
+    }
+
+    AudioSource* source = nullptr;
+    const int numBlocksAhead;
+    const int numChannels;
+    int blockSize = 0;
+    double sampleRate = 0.0;
+
+    std::unique_ptr<AudioFifo> fifo;
+    AudioBuffer<float> renderBuffer;
+    std::vector<float*> channelPointers;
+    std::atomic<bool> failed { false };
+};
+
+// ============================================================================================
+
+/**
+ * @brief A midi event record of a columnar midi event array.
+ *
+ * Messages of up to three bytes are stored inline, while sysex and longer messages are stored as a range of a separate
+ * bytes object holding the complete raw message.
+ */
+struct MidiEventRecord
+{
+    static constexpr const char* format = "T{=i:samplePosition:B:status:B:data1:B:data2:x:i:sysexOffset:i:sysexSize:}";
+
+    int32 samplePosition = 0;
+    uint8 status = 0;
+    uint8 data1 = 0;
+    uint8 data2 = 0;
+    uint8 reserved = 0;
+    int32 sysexOffset = 0;
+    int32 sysexSize = 0;
+};
+
+static_assert (sizeof (MidiEventRecord) == 16);
+
+/**
+ * @brief A contiguous array of records, exposed to python as a structured buffer described by the record format.
+ */
+template <class Record>
+struct RecordArray
+{
+    std::vector<Record> events;
+};
+
+using MidiEventArray = RecordArray<MidiEventRecord>;
+
+/**
+ * @brief A named field of a structured buffer format, with its type code normalized to the standard sizes.
+ */
+struct RecordFormatField
+{
+    std::string name;
+    char code = 0;
+    size_t offset = 0;
+    size_t size = 0;
+};
+
+std::optional<std::vector<RecordFormatField>> parseRecordFormat (std::string_view format)
+{
+    if (format.size() < 3 || format.substr (0, 2) != "T{" || format.back() != '}')
+        return std::nullopt;
+
+    format = format.substr (2, format.size() - 3);
+
+    std::vector<RecordFormatField> fields;
+    size_t offset = 0;
+    bool nativeSizes = true;
+    bool nativeAlignment = true;
+
+    for (size_t index = 0; index < format.size();)
+    {
+        const auto prefix = format[index];
+
+        if (prefix == '@' || prefix == '=' || prefix == '<' || prefix == '>' || prefix == '!' || prefix == '^')
+        {
+            const auto isBigEndian = prefix == '>' || prefix == '!';
+            if (isBigEndian != ByteOrder::isBigEndian())
+                return std::nullopt;
+
+            nativeSizes = prefix == '@' || prefix == '^';
+            nativeAlignment = prefix == '@';
+            ++index;
+            continue;
+        }
+
+        size_t count = 0;
+        while (index < format.size() && CharacterFunctions::isDigit (format[index]))
+            count = count * 10 + static_cast<size_t> (format[index++] - '0');
+
+        if (index >= format.size())
+            return std::nullopt;
+
+        auto code = format[index++];
+        count = jmax (size_t (1), count);
+
+        if (code == 'x')
+        {
+            offset += count;
+            continue;
+        }
+
+        size_t size = 0;
+        switch (code)
+        {
+            case 'b': case 'B': case 'c': case '?': size = 1; break;
+            case 'h': case 'H': size = 2; break;
+            case 'i': case 'I': case 'f': size = 4; break;
+            case 'l': size = nativeSizes ? sizeof (long) : 4; code = size == 4 ? 'i' : 'q'; break;
+            case 'L': size = nativeSizes ? sizeof (unsigned long) : 4; code = size == 4 ? 'I' : 'Q'; break;
+            case 'q': case 'Q': case 'd': size = 8; break;
+            default: return std::nullopt;
+        }
+
+        if (nativeAlignment)
+            offset = (offset + size - 1) / size * size;
+
+        const auto nameEnd = index < format.size() && format[index] == ':' ? format.find (':', index + 1) : std::string_view::npos;
+        if (nameEnd == std::string_view::npos)
+            return std::nullopt;
+
+        fields.push_back ({ std::string (format.substr (index + 1, nameEnd - index - 1)), code, offset, size * count });
+
+        offset += size * count;
+        index = nameEnd + 1;
+    }
+
+    return fields;
+}
+
+/** Returns true if a buffer holds records laid out as Record, regardless of how its format string is spelled. */
+template <class Record>
+bool isBufferOfRecords (const py::buffer_info& info)
+{
+    if (info.itemsize != static_cast<py::ssize_t> (sizeof (Record)))
+        return false;
+
+    if (info.format == Record::format)
+        return true;
+
+    static const auto expectedFields = parseRecordFormat (Record::format);
+    const auto fields = parseRecordFormat (info.format);
+    if (! expectedFields || ! fields)
+        return false;
+
+    for (const auto& expected : *expectedFields)
+    {
+        const auto matches = std::any_of (fields->begin(), fields->end(), [&](const auto& field)
+        {
+            return field.name == expected.name && field.code == expected.code && field.offset == expected.offset && field.size == expected.size;
+        });
+
+        if (! matches)
+            return false;
+    }
+
+    // Any other field must live in the padding of the record, like a named reserved byte
+    return std::all_of (fields->begin(), fields->end(), [&](const auto& field)
+    {
+        return std::any_of (expectedFields->begin(), expectedFields->end(), [&](const auto& expected) { return field.name == expected.name; })
+            || std::none_of (expectedFields->begin(), expectedFields->end(), [&](const auto& expected)
+               {
+                   return field.offset < expected.offset + expected.size && expected.offset < field.offset + field.size;
+               });
+    });
+}
+
+template <class Record>
+void registerRecordArray (py::module_& m, const char* name)
+{
+    py::class_<RecordArray<Record>> (m, name, py::buffer_protocol())
+        .def (py::init ([](size_t numEvents)
+        {
+            RecordArray<Record> result;
+            result.events.resize (numEvents);
+            return result;
+        }), "numEvents"_a = 0)
+        .def ("__len__", [](const RecordArray<Record>& self) { return self.events.size(); })
+        .def_buffer ([](RecordArray<Record>& self) -> py::buffer_info
+        {
+            static Record emptyRecord;
+
+            return py::buffer_info (
+                self.events.empty() ? &emptyRecord : self.events.data(),
+                static_cast<py::ssize_t> (sizeof (Record)),
+                Record::format,
+                1,
+                { static_cast<py::ssize_t> (self.events.size()) },
+                { static_cast<py::ssize_t> (sizeof (Record)) },
+                false);
+        })
+    ;
+}
+
+void appendMidiEventRecord (std::vector<MidiEventRecord>& events, std::string& sysexData, const uint8* data, int numBytes, int samplePosition)
+{
+    auto& record = events.emplace_back();
+    record.samplePosition = samplePosition;
+    record.status = numBytes > 0 ? data[0] : 0;
+
+    if (numBytes <= 3 && record.status != 0xf0)
+    {
+        record.data1 = numBytes > 1 ? data[1] : 0;
+        record.data2 = numBytes > 2 ? data[2] : 0;
+    }
+    else
+    {
+        record.sysexOffset = static_cast<int32> (sysexData.size());
+        record.sysexSize = numBytes;
+        sysexData.append (reinterpret_cast<const char*> (data), static_cast<size_t> (numBytes));
+    }
+}
+
+py::tuple exportMidiEvents (const MidiBuffer& buffer, int startSample, int numSamples)
+{
+    MidiEventArray result;
+    std::string sysexData;
+
+    callReleasingGILForLargeSpans (static_cast<size_t> (buffer.data.size()), [&]
+    {
+        result.events.reserve (static_cast<size_t> (buffer.getNumEvents()));
+
+        const auto endSample = numSamples < 0 ? std::numeric_limits<int>::max() : startSample + numSamples;
+
+        for (auto it = buffer.findNextSamplePosition (startSample); it != buffer.end(); ++it)
+        {
+            const auto metadata = *it;
+            if (metadata.samplePosition >= endSample)
+                break;
+
+            appendMidiEventRecord (result.events, sysexData, metadata.data, metadata.numBytes, metadata.samplePosition);
+        }
+    });
+
+    return py::make_tuple (py::cast (std::move (result)), py::bytes (sysexData));
+}
+
+void addMidiEvents (MidiBuffer& buffer, py::buffer events, py::object sysexData, int sampleDeltaToAdd)
+{
+    const auto info = events.request();
+
+    if (info.ndim != 1 || ! isBufferOfRecords<MidiEventRecord> (info))
+        py::pybind11_fail ("Midi events must be a one dimensional array of midi event records");
+
+    std::optional<py::buffer_info> sysexInfo;
+    if (! sysexData.is_none())
+        sysexInfo = getContiguousBufferInfo (sysexData.cast<py::buffer>(), false);
+
+    const auto sysexBytes = sysexInfo ? static_cast<const uint8*> (sysexInfo->ptr) : nullptr;
+    const auto numSysexBytes = sysexInfo ? static_cast<int64> (getBufferSizeInBytes (*sysexInfo)) : 0;
+
+    struct PendingEvent
+    {
+        int samplePosition = 0;
+        uint8 shortMessage[3] {};
+        const uint8* data = nullptr;
+        int numBytes = 0;
+    };
+
+    MidiBuffer merged;
+
+    callReleasingGILForLargeSpans (static_cast<size_t> (info.shape[0]), [&]
+    {
+        // All the records are validated before touching the buffer, so an invalid one leaves it unchanged
+        std::vector<PendingEvent> pending (static_cast<size_t> (info.shape[0]));
+
+        for (py::ssize_t index = 0; index < info.shape[0]; ++index)
+        {
+            MidiEventRecord record;
+            std::memcpy (&record, static_cast<const char*> (info.ptr) + index * info.strides[0], sizeof (MidiEventRecord));
+
+            auto& event = pending[static_cast<size_t> (index)];
+            event.samplePosition = record.samplePosition + sampleDeltaToAdd;
+
+            if (record.sysexSize > 0)
+            {
+                if (record.sysexOffset < 0 || static_cast<int64> (record.sysexOffset) + record.sysexSize > numSysexBytes)
+                    py::pybind11_fail ("Midi event sysex range is outside of the sysex data");
+
+                if (record.sysexSize > std::numeric_limits<uint16>::max())
+                    py::pybind11_fail ("Midi event is too large");
+
+                event.data = sysexBytes + record.sysexOffset;
+                event.numBytes = record.sysexSize;
+            }
+            else
+            {
+                if (record.status < 0x80 || record.status == 0xf0)
+                    py::pybind11_fail ("Midi event has an invalid status byte");
+
+                event.shortMessage[0] = record.status;
+                event.shortMessage[1] = record.data1;
+                event.shortMessage[2] = record.data2;
+                event.numBytes = MidiMessage::getMessageLengthFromFirstByte (record.status);
+            }
+        }
+
+        std::stable_sort (pending.begin(), pending.end(), [](const auto& a, const auto& b)
+        {
+            return a.samplePosition < b.samplePosition;
+        });
+
+        auto numBytesToAdd = static_cast<size_t> (buffer.data.size());
+        for (const auto& event : pending)
+            numBytesToAdd += sizeof (int32) + sizeof (uint16) + static_cast<size_t> (event.numBytes);
+
+        merged.ensureSize (numBytesToAdd);
+
+        // Merge in time order, existing events go first at equal positions like repeated calls to addEvent would do
+        auto existing = buffer.cbegin();
+        auto next = pending.cbegin();
+
+        while (existing != buffer.cend() || next != pending.cend())
+        {
+            if (next == pending.cend() || (existing != buffer.cend() && (*existing).samplePosition <= next->samplePosition))
+            {
+                const auto metadata = *existing;
+                ++existing;
+
+                merged.addEvent (metadata.data, metadata.numBytes, metadata.samplePosition);
+            }
+            else
+            {
+                merged.addEvent (next->data != nullptr ? next->data : next->shortMessage, next->numBytes, next->samplePosition);
+                ++next;
+            }
+        }
+    });
+
+    buffer.swapWith (merged);
+}
+
+// ============================================================================================
+
+/**
+ * @brief A midi file event record of the columnar arrays of a parsed midi file track.
+ *
+ * Meta events are stored with a 0xff status, their meta type and their payload in the track data, sysex and other long
+ * messages with their complete raw message in the track data, while the shorter messages are stored inline.
+ */
+struct MidiFileEventRecord
+{
+    static constexpr const char* format = "T{=d:tick:d:timeInSeconds:B:status:B:data1:B:data2:B:metaType:i:dataOffset:i:dataSize:4x:}";
+
+    double tick = 0.0;
+    double timeInSeconds = 0.0;
+    uint8 status = 0;
+    uint8 data1 = 0;
+    uint8 data2 = 0;
+    uint8 metaType = 0;
+    int32 dataOffset = 0;
+    int32 dataSize = 0;
+    int32 reserved = 0;
+};
+
+static_assert (sizeof (MidiFileEventRecord) == 32);
+
+using MidiFileEventArray = RecordArray<MidiFileEventRecord>;
+
+struct ParsedMidiFile
+{
+    struct Track
+    {
+        MidiFileEventArray events;
+        std::string data;
+    };
+
+    bool wasParsed = false;
+    int fileType = 0;
+    short timeFormat = 0;
+    std::vector<Track> tracks;
+};
+
+void extractMidiFileTracks (const MidiFile& file, ParsedMidiFile& result)
+{
+    // Tempo changes can live on any track, so seconds are computed by JUCE on a copy of the whole file
+    MidiFile timedFile (file);
+    timedFile.convertTimestampTicksToSeconds();
+
+    result.timeFormat = file.getTimeFormat();
+    result.tracks.resize (static_cast<size_t> (file.getNumTracks()));
 
-    classFloatArrayView
-        .def ("__getitem__", [](PyArrayView<float>& self, size_t index)
-        {
-            if (self.data() == nullptr || index >= self.size())
-                pybind11::pybind11_fail ("Out of bound access of array data");
+    for (int trackIndex = 0; trackIndex < file.getNumTracks(); ++trackIndex)
+    {
+        const auto& sequence = *file.getTrack (trackIndex);
+        const auto& timedSequence = *timedFile.getTrack (trackIndex);
+        auto& track = result.tracks[static_cast<size_t> (trackIndex)];
 
-            return *(self.data() + index);
-        })
-        .def ("__setitem__", [](PyArrayView<float>& self, size_t index, float value)
-        {
-            if (index >= self.size())
-                pybind11::pybind11_fail ("Out of bound access of channel data");
+        track.events.events.reserve (static_cast<size_t> (sequence.getNumEvents()));
 
-            *(self.data() + index) = value;
-        })
-        .def ("__len__", &PyArrayView<float>::size)
-        .def ("__iter__", [](PyArrayView<float>& self)
+        for (int eventIndex = 0; eventIndex < sequence.getNumEvents(); ++eventIndex)
         {
-            if (self.data() == nullptr)
-                pybind11::pybind11_fail ("Invalid empty array");
+            const auto& message = sequence.getEventPointer (eventIndex)->message;
+            const auto data = message.getRawData();
+            const auto numBytes = message.getRawDataSize();
 
-            return py::make_iterator (self.data(), self.data() + self.size());
-        })
-        .def_buffer ([](PyArrayView<float>& self) -> py::buffer_info
-        {
-            return py::buffer_info (self.data(), static_cast<ssize_t> (self.size()), false);
-        })
-    ;
+            auto& record = track.events.events.emplace_back();
+            record.tick = message.getTimeStamp();
+            record.timeInSeconds = timedSequence.getEventPointer (eventIndex)->message.getTimeStamp();
+            record.status = numBytes > 0 ? data[0] : 0;
 
-    // ============================================================================================ juce::DoubleArrayView
+            const auto appendData = [&] (const uint8* bytes, int size)
+            {
+                record.dataOffset = static_cast<int32> (track.data.size());
+                record.dataSize = size;
+                track.data.append (reinterpret_cast<const char*> (bytes), static_cast<size_t> (size));
+            };
 
-    py::class_<PyArrayView<const double>> classConstDoubleArrayView (m, "ConstDoubleArrayView", py::buffer_protocol());
+            if (message.isMetaEvent())
+            {
+                record.metaType = static_cast<uint8> (message.getMetaEventType());
+                appendData (message.getMetaEventData(), message.getMetaEventLength());
+            }
+            else if (numBytes <= 3 && record.status != 0xf0)
+            {
+                record.data1 = numBytes > 1 ? data[1] : 0;
+                record.data2 = numBytes > 2 ? data[2] : 0;
+            }
+            else
+            {
+                appendData (data, numBytes);
+            }
+        }
+    }
+}
 
-    classConstDoubleArrayView
-        .def ("__getitem__", [](PyArrayView<const double>& self, size_t index)
-        {
-            if (self.data() == nullptr || index >= self.size())
-                pybind11::pybind11_fail ("Out of bound access of array data");
+ParsedMidiFile parseMidiFile (InputStream& stream, bool createMatchingNoteOffs)
+{
+    ParsedMidiFile result;
 
-            return *(self.data() + index);
-        })
-        .def ("__len__", &PyArrayView<const double>::size)
-        .def ("__iter__", [](PyArrayView<const double>& self)
-        {
-            if (self.data() == nullptr)
-                pybind11::pybind11_fail ("Invalid empty array");
+    MidiFile file;
+    if (! file.readFrom (stream, createMatchingNoteOffs, &result.fileType))
+        return result;
 
-            return py::make_iterator (self.data(), self.data() + self.size());
-        })
-        .def_buffer ([](PyArrayView<const double>& self) -> py::buffer_info
-        {
-            return py::buffer_info (self.data(), static_cast<ssize_t> (self.size()), true);
-        })
-    ;
+    result.wasParsed = true;
+    extractMidiFileTracks (file, result);
+    return result;
+}
 
-    py::class_<PyArrayView<double>> classDoubleArrayView (m, "DoubleArrayView", py::buffer_protocol());
+py::object createMidiFileArrays (ParsedMidiFile&& parsed)
+{
+    if (! parsed.wasParsed)
+        return py::none();
+
+    py::list tracks;
+    for (auto& track : parsed.tracks)
+        tracks.append (py::make_tuple (py::cast (std::move (track.events)), py::bytes (track.data)));
+
+    py::dict result;
+    result["fileType"] = parsed.fileType;
+    result["timeFormat"] = parsed.timeFormat;
+    result["tracks"] = std::move (tracks);
+    return result;
+}
 
-    classDoubleArrayView
-        .def ("__getitem__", [](PyArrayView<double>& self, size_t index)
+/**
+ * @brief A midi file source gathered while holding the GIL, that can be opened and parsed from any thread.
+ */
+struct MidiFileSource
+{
+    explicit MidiFileSource (py::handle source)
+    {
+        if (py::isinstance<File> (source))
         {
-            if (self.data() == nullptr || index >= self.size())
-                pybind11::pybind11_fail ("Out of bound access of array data");
-
-            return *(self.data() + index);
-        })
-        .def ("__setitem__", [](PyArrayView<double>& self, size_t index, double value)
+            file = source.cast<File>();
+        }
+        else if (py::isinstance<InputStream> (source))
         {
-            if (index >= self.size())
-                pybind11::pybind11_fail ("Out of bound access of channel data");
-
-            *(self.data() + index) = value;
-        })
-        .def ("__len__", &PyArrayView<double>::size)
-        .def ("__iter__", [](PyArrayView<double>& self)
+            // Streams could be implemented in python, so they are fully read before releasing the GIL
+            source.cast<InputStream&>().readIntoMemoryBlock (ownedData);
+            data = ownedData.getData();
+            size = ownedData.getSize();
+        }
+        else if (py::isinstance<MemoryBlock> (source))
         {
-            if (self.data() == nullptr)
-                pybind11::pybind11_fail ("Invalid empty array");
+            auto& block = source.cast<MemoryBlock&>();
+            data = block.getData();
+            size = block.getSize();
+        }
+        else
+        {
+            info = getContiguousBufferInfo (source.cast<py::buffer>(), false);
+            data = info->ptr;
+            size = getBufferSizeInBytes (*info);
+        }
 
-            return py::make_iterator (self.data(), self.data() + self.size());
-        })
-        .def_buffer ([](PyArrayView<double>& self) -> py::buffer_info
+        keepAlive = py::reinterpret_borrow<py::object> (source);
+    }
+
+    ParsedMidiFile parse (bool createMatchingNoteOffs) const
+    {
+        if (data == nullptr && file != File())
         {
-            return py::buffer_info (self.data(), static_cast<ssize_t> (self.size()), false);
-        })
-    ;
+            FileInputStream stream (file);
+            if (! stream.openedOk())
+                return {};
 
-    // ============================================================================================ juce::IntArrayView
+            return parseMidiFile (stream, createMatchingNoteOffs);
+        }
 
-    py::class_<PyArrayView<const int>> classConstIntArrayView (m, "ConstIntArrayView", py::buffer_protocol());
+        MemoryInputStream stream (data, size, false);
+        return parseMidiFile (stream, createMatchingNoteOffs);
+    }
 
-    classConstIntArrayView
-        .def ("__getitem__", [](PyArrayView<const int>& self, size_t index)
-        {
-            if (self.data() == nullptr || index >= self.size())
-                pybind11::pybind11_fail ("Out of bound access of array data");
+    File file;
+    const void* data = nullptr;
+    size_t size = 0;
+    MemoryBlock ownedData;
+    std::optional<py::buffer_info> info;
+    py::object keepAlive;
+};
 
-            return *(self.data() + index);
-        })
-        .def ("__len__", &PyArrayView<const int>::size)
-        .def ("__iter__", [](PyArrayView<const int>& self)
-        {
-            if (self.data() == nullptr)
-                pybind11::pybind11_fail ("Invalid empty array");
+// ============================================================================================
 
-            return py::make_iterator (self.data(), self.data() + self.size());
-        })
-        .def_buffer ([](PyArrayView<const int>& self) -> py::buffer_info
-        {
-            return py::buffer_info (self.data(), static_cast<ssize_t> (self.size()), true);
-        })
-    ;
+void registerJuceAudioBasicsBindings (py::module_& m)
+{
+    // ============================================================================================ juce::FloatArrayView
 
-    py::class_<PyArrayView<int>> classIntArrayView (m, "IntArrayView", py::buffer_protocol());
+    registerArrayView<const float> (m, "ConstFloatArrayView");
+    registerArrayView<float> (m, "FloatArrayView");
 
-    classIntArrayView
-        .def ("__getitem__", [](PyArrayView<int>& self, size_t index)
-        {
-            if (self.data() == nullptr || index >= self.size())
-                pybind11::pybind11_fail ("Out of bound access of array data");
+    // ============================================================================================ juce::DoubleArrayView
 
-            return *(self.data() + index);
-        })
-        .def ("__setitem__", [](PyArrayView<int>& self, size_t index, int value)
-        {
-            if (index >= self.size())
-                pybind11::pybind11_fail ("Out of bound access of channel data");
+    registerArrayView<const double> (m, "ConstDoubleArrayView");
+    registerArrayView<double> (m, "DoubleArrayView");
 
-            *(self.data() + index) = value;
-        })
-        .def ("__len__", &PyArrayView<int>::size)
-        .def ("__iter__", [](PyArrayView<int>& self)
-        {
-            if (self.data() == nullptr)
-                pybind11::pybind11_fail ("Invalid empty array");
+    // ============================================================================================ juce::IntArrayView
 
-            return py::make_iterator (self.data(), self.data() + self.size());
-        })
-        .def_buffer ([](PyArrayView<int>& self) -> py::buffer_info
-        {
-            return py::buffer_info (self.data(), static_cast<ssize_t> (self.size()), false);
-        })
-    ;
+    registerArrayView<const int> (m, "ConstIntArrayView");
+    registerArrayView<int> (m, "IntArrayView");
 
     // ============================================================================================ juce::AudioBuffer
 
@@ -319,6 +2470,38 @@ void registerJuceAudioBasicsBindings (py::module_& m)
 
     m.attr ("AudioSampleBuffer") = m.attr ("AudioBuffer")[py::type::of (py::cast (float{}))];
 
+    // ============================================================================================ popsicle::AudioBufferPool
+
+    registerAudioBufferPool<float, double> (m);
+
+    // ============================================================================================ juce::AudioData
+
+    py::class_<AudioData> classAudioData (m, "AudioData");
+
+    py::enum_<PCMSampleFormat> (classAudioData, "SampleFormat")
+        .value ("int8", PCMSampleFormat::int8)
+        .value ("uint8", PCMSampleFormat::uint8)
+        .value ("int16", PCMSampleFormat::int16)
+        .value ("int24", PCMSampleFormat::int24)
+        .value ("int32", PCMSampleFormat::int32)
+        .value ("float32", PCMSampleFormat::float32)
+        .export_values();
+
+    py::enum_<PCMEndianness> (classAudioData, "Endianness")
+        .value ("littleEndian", PCMEndianness::littleEndian)
+        .value ("bigEndian", PCMEndianness::bigEndian)
+        .export_values();
+
+    classAudioData
+        .def_static ("getBytesPerSample", [](PCMSampleFormat format) { return getPCMConverters (format, PCMEndianness::littleEndian).bytesPerSample; }, "format"_a)
+        .def_static ("interleaveSamples", &interleaveAudioBuffer,
+            "source"_a, "dest"_a, "format"_a, "endianness"_a = PCMEndianness::littleEndian, "startSample"_a = 0, "numSamples"_a = -1)
+        .def_static ("deinterleaveSamples", &deinterleaveAudioBuffer,
+            "source"_a, "dest"_a, "format"_a, "endianness"_a = PCMEndianness::littleEndian, "startSample"_a = 0, "numSamples"_a = -1)
+        .def_static ("convertSamples", &convertPCMSamples,
+            "source"_a, "sourceFormat"_a, "sourceEndianness"_a, "dest"_a, "destFormat"_a, "destEndianness"_a, "numSamples"_a = -1)
+    ;
+
     // ============================================================================================ juce::AudioChannelSet
 
     py::class_<AudioChannelSet> classAudioChannelSet (m, "AudioChannelSet");
@@ -523,6 +2706,58 @@ void registerJuceAudioBasicsBindings (py::module_& m)
         .def ("registerRenderTime", &AudioProcessLoadMeasurer::registerRenderTime)
     ;
 
+    // ============================================================================================ popsicle::CallbackDeadlineMonitor
+
+    py::class_<PyCallbackDeadlineMonitor> classCallbackDeadlineMonitor (m, "CallbackDeadlineMonitor");
+
+    py::enum_<PyCallbackDeadlineMonitor::FallbackPolicy> (classCallbackDeadlineMonitor, "FallbackPolicy")
+        .value ("none", PyCallbackDeadlineMonitor::FallbackPolicy::none)
+        .value ("silence", PyCallbackDeadlineMonitor::FallbackPolicy::silence)
+        .value ("repeatLastBlock", PyCallbackDeadlineMonitor::FallbackPolicy::repeatLastBlock)
+        .value ("bypass", PyCallbackDeadlineMonitor::FallbackPolicy::bypass)
+        .export_values();
+
+    classCallbackDeadlineMonitor
+        .def ("setEnabled", &PyCallbackDeadlineMonitor::setEnabled, "shouldBeEnabled"_a)
+        .def ("isEnabled", &PyCallbackDeadlineMonitor::isEnabled)
+        .def ("setDeadlineRatio", &PyCallbackDeadlineMonitor::setDeadlineRatio, "newRatio"_a)
+        .def ("getDeadlineRatio", &PyCallbackDeadlineMonitor::getDeadlineRatio)
+        .def ("setFallbackPolicy", &PyCallbackDeadlineMonitor::setFallbackPolicy, "newPolicy"_a, "maxConsecutiveMisses"_a = 1)
+        .def ("getFallbackPolicy", &PyCallbackDeadlineMonitor::getFallbackPolicy)
+        .def ("getMaxConsecutiveMisses", &PyCallbackDeadlineMonitor::getMaxConsecutiveMisses)
+        .def ("setRetryInterval", &PyCallbackDeadlineMonitor::setRetryInterval, "numBlocks"_a)
+        .def ("getRetryInterval", &PyCallbackDeadlineMonitor::getRetryInterval)
+        .def ("setMaxNumChannels", &PyCallbackDeadlineMonitor::setMaxNumChannels, "newMaxNumChannels"_a)
+        .def ("getMaxNumChannels", &PyCallbackDeadlineMonitor::getMaxNumChannels)
+        .def ("isInFallback", &PyCallbackDeadlineMonitor::isInFallback)
+        .def ("resetFallback", &PyCallbackDeadlineMonitor::resetFallback)
+        .def ("getNumCallbacks", &PyCallbackDeadlineMonitor::getNumCallbacks)
+        .def ("getNumMisses", &PyCallbackDeadlineMonitor::getNumMisses)
+        .def ("getNumConsecutiveMisses", &PyCallbackDeadlineMonitor::getNumConsecutiveMisses)
+        .def ("getNumFallbackBlocks", &PyCallbackDeadlineMonitor::getNumFallbackBlocks)
+        .def ("getNumTruncatedBlocks", &PyCallbackDeadlineMonitor::getNumTruncatedBlocks)
+        .def ("getMaxCallbackMilliseconds", &PyCallbackDeadlineMonitor::getMaxCallbackMilliseconds)
+        .def ("getHistogram", [](const PyCallbackDeadlineMonitor& self)
+        {
+            py::list result (PyCallbackDeadlineMonitor::numHistogramBins);
+
+            for (int bin = 0; bin < PyCallbackDeadlineMonitor::numHistogramBins; ++bin)
+                result[static_cast<size_t> (bin)] = self.getHistogramBin (bin);
+
+            return result;
+        })
+        .def_static ("getHistogramBinEdges", []
+        {
+            py::list result;
+
+            for (const auto edge : PyCallbackDeadlineMonitor::histogramBinEdges)
+                result.append (edge);
+
+            return result;
+        })
+        .def ("resetStatistics", &PyCallbackDeadlineMonitor::resetStatistics)
+    ;
+
     // ============================================================================================ juce::AudioSourceChannelInfo
 
     py::class_<AudioSourceChannelInfo> classAudioSourceChannelInfo (m, "AudioSourceChannelInfo");
@@ -546,6 +2781,13 @@ void registerJuceAudioBasicsBindings (py::module_& m)
         .def ("prepareToPlay", &AudioSource::prepareToPlay)
         .def ("releaseResources", &AudioSource::releaseResources)
         .def ("getNextAudioBlock", &AudioSource::getNextAudioBlock)
+        .def ("getDeadlineMonitor", [](AudioSource& self) -> PyCallbackDeadlineMonitor*
+        {
+            if (auto state = dynamic_cast<PyAudioSourceState*> (&self))
+                return &state->getDeadlineMonitor();
+
+            return nullptr;
+        }, py::return_value_policy::reference_internal)
     ;
 
     py::class_<PositionableAudioSource, AudioSource, PyPositionableAudioSource<>> classPositionableAudioSource (m, "PositionableAudioSource");
@@ -631,6 +2873,316 @@ void registerJuceAudioBasicsBindings (py::module_& m)
         .def ("setFrequency", &ToneGeneratorAudioSource::setFrequency)
     ;
 
+    // ============================================================================================ popsicle::AudioFifo
+
+    py::class_<AudioFifoRegion> (m, "AudioFifoRegion", py::buffer_protocol())
+        .def ("getNumChannels", [](const AudioFifoRegion& self) { return self.numChannels; })
+        .def ("getNumSamples", [](const AudioFifoRegion& self) { return self.numSamples; })
+        .def ("isReadOnly", [](const AudioFifoRegion& self) { return self.readOnly; })
+        .def ("__len__", [](const AudioFifoRegion& self) { return self.numSamples; })
+        .def_buffer ([](AudioFifoRegion& self) -> py::buffer_info
+        {
+            constexpr auto itemSize = static_cast<py::ssize_t> (sizeof (float));
+
+            return py::buffer_info (
+                self.data,
+                itemSize,
+                py::format_descriptor<float>::format(),
+                2,
+                { static_cast<py::ssize_t> (self.numChannels), static_cast<py::ssize_t> (self.numSamples) },
+                { static_cast<py::ssize_t> (self.channelStride) * itemSize, itemSize },
+                self.readOnly);
+        })
+    ;
+
+    py::class_<AudioFifo> classAudioFifo (m, "AudioFifo");
+
+    classAudioFifo
+        .def (py::init<int, int>(), "numChannels"_a, "capacity"_a)
+        .def ("getNumChannels", &AudioFifo::getNumChannels)
+        .def ("getCapacity", &AudioFifo::getCapacity)
+        .def ("getNumReady", &AudioFifo::getNumReady)
+        .def ("getFreeSpace", &AudioFifo::getFreeSpace)
+        .def ("write", [](AudioFifo& self, py::buffer source)
+        {
+            const auto info = source.request();
+
+            int numSamples = 0;
+            const auto channels = getBufferChannelPointers<const float> (info, numSamples);
+
+            int numWritten = 0;
+            callReleasingGILForLargeSpans (channels.size() * static_cast<size_t> (numSamples), [&]
+            {
+                numWritten = self.write (channels.data(), static_cast<int> (channels.size()), numSamples);
+            });
+
+            return numWritten;
+        }, "source"_a)
+        .def ("write", [](AudioFifo& self, py::list sourceChannels)
+        {
+            std::vector<py::buffer_info> infos;
+
+            int numSamples = 0;
+            const auto channels = getChannelBufferListPointers<const float> (sourceChannels, infos, numSamples);
+
+            int numWritten = 0;
+            callReleasingGILForLargeSpans (channels.size() * static_cast<size_t> (numSamples), [&]
+            {
+                numWritten = self.write (channels.data(), static_cast<int> (channels.size()), numSamples);
+            });
+
+            return numWritten;
+        }, "sourceChannels"_a)
+        .def ("read", [](AudioFifo& self, py::buffer dest)
+        {
+            const auto info = dest.request (true);
+
+            int numSamples = 0;
+            const auto channels = getBufferChannelPointers<float> (info, numSamples);
+
+            int numRead = 0;
+            callReleasingGILForLargeSpans (channels.size() * static_cast<size_t> (numSamples), [&]
+            {
+                numRead = self.read (channels.data(), static_cast<int> (channels.size()), numSamples);
+            });
+
+            return numRead;
+        }, "dest"_a)
+        .def ("read", [](AudioFifo& self, py::list destChannels)
+        {
+            std::vector<py::buffer_info> infos;
+
+            int numSamples = 0;
+            const auto channels = getChannelBufferListPointers<float> (destChannels, infos, numSamples);
+
+            int numRead = 0;
+            callReleasingGILForLargeSpans (channels.size() * static_cast<size_t> (numSamples), [&]
+            {
+                numRead = self.read (channels.data(), static_cast<int> (channels.size()), numSamples);
+            });
+
+            return numRead;
+        }, "destChannels"_a)
+        .def ("prepareToWrite", [](py::object self, int numToWrite)
+        {
+            auto& fifo = self.cast<AudioFifo&>();
+
+            int startIndex1 = 0, blockSize1 = 0, startIndex2 = 0, blockSize2 = 0;
+            fifo.prepareToWrite (numToWrite, startIndex1, blockSize1, startIndex2, blockSize2);
+
+            return getAudioFifoRegions (fifo, self, startIndex1, blockSize1, startIndex2, blockSize2, false);
+        }, "numToWrite"_a)
+        .def ("finishedWrite", &AudioFifo::finishedWrite, "numWritten"_a)
+        .def ("prepareToRead", [](py::object self, int numWanted)
+        {
+            auto& fifo = self.cast<AudioFifo&>();
+
+            int startIndex1 = 0, blockSize1 = 0, startIndex2 = 0, blockSize2 = 0;
+            fifo.prepareToRead (numWanted, startIndex1, blockSize1, startIndex2, blockSize2);
+
+            return getAudioFifoRegions (fifo, self, startIndex1, blockSize1, startIndex2, blockSize2, true);
+        }, "numWanted"_a)
+        .def ("finishedRead", &AudioFifo::finishedRead, "numRead"_a)
+        .def ("reset", &AudioFifo::reset)
+        .def ("getNumOverruns", &AudioFifo::getNumOverruns)
+        .def ("getNumUnderruns", &AudioFifo::getNumUnderruns)
+        .def ("resetCounters", &AudioFifo::resetCounters)
+    ;
+
+    // ============================================================================================ popsicle::LevelMeterBank
+
+    py::class_<LevelMeterBank> classLevelMeterBank (m, "LevelMeterBank");
+
+    classLevelMeterBank
+        .def (py::init<int, float>(), "numChannels"_a, "clipThreshold"_a = 1.0f)
+        .def ("getNumChannels", &LevelMeterBank::getNumChannels)
+        .def ("setClipThreshold", &LevelMeterBank::setClipThreshold, "newThreshold"_a)
+        .def ("getClipThreshold", &LevelMeterBank::getClipThreshold)
+        .def ("process", [](LevelMeterBank& self, py::buffer source)
+        {
+            const auto info = source.request();
+
+            int numSamples = 0;
+            const auto channels = getBufferChannelPointers<const float> (info, numSamples);
+
+            callReleasingGILForLargeSpans (channels.size() * static_cast<size_t> (numSamples), [&]
+            {
+                self.process (channels.data(), static_cast<int> (channels.size()), 0, numSamples);
+            });
+        }, "source"_a)
+        .def ("process", [](LevelMeterBank& self, py::list sourceChannels)
+        {
+            std::vector<py::buffer_info> infos;
+
+            int numSamples = 0;
+            const auto channels = getChannelBufferListPointers<const float> (sourceChannels, infos, numSamples);
+
+            callReleasingGILForLargeSpans (channels.size() * static_cast<size_t> (numSamples), [&]
+            {
+                self.process (channels.data(), static_cast<int> (channels.size()), 0, numSamples);
+            });
+        }, "sourceChannels"_a)
+        .def ("getSnapshot", [](LevelMeterBank& self)
+        {
+            const auto numValues = static_cast<size_t> (self.getNumChannels() * LevelMeterBank::numFields);
+
+            py::bytearray data (std::string (numValues * sizeof (double), '\0'));
+
+            self.getSnapshot (reinterpret_cast<double*> (PyByteArray_AsString (data.ptr())));
+
+            return py::memoryview (data).attr ("cast") ("d", py::make_tuple (self.getNumChannels(), static_cast<int> (LevelMeterBank::numFields)));
+        })
+        .def ("getSnapshot", [](LevelMeterBank& self, py::buffer dest)
+        {
+            const auto info = getContiguousBufferInfo (dest, true);
+
+            if (! isBufferOfType<double> (info))
+                py::pybind11_fail ("Level meter snapshot buffer must hold doubles");
+
+            if (info.size < static_cast<py::ssize_t> (self.getNumChannels() * LevelMeterBank::numFields))
+                py::pybind11_fail ("Level meter snapshot buffer is too small");
+
+            return self.getSnapshot (static_cast<double*> (info.ptr));
+        }, "dest"_a)
+        .def ("reset", &LevelMeterBank::reset)
+        .def_property_readonly_static ("peakField", [](py::object) { return static_cast<int> (LevelMeterBank::peakField); })
+        .def_property_readonly_static ("rmsField", [](py::object) { return static_cast<int> (LevelMeterBank::rmsField); })
+        .def_property_readonly_static ("truePeakField", [](py::object) { return static_cast<int> (LevelMeterBank::truePeakField); })
+        .def_property_readonly_static ("clipCountField", [](py::object) { return static_cast<int> (LevelMeterBank::clipCountField); })
+        .def_property_readonly_static ("numFields", [](py::object) { return static_cast<int> (LevelMeterBank::numFields); })
+    ;
+
+    // ============================================================================================ popsicle::AudioResampler
+
+    py::class_<AudioResampler> classAudioResampler (m, "AudioResampler");
+
+    py::enum_<ResamplingQuality> (classAudioResampler, "Quality")
+        .value ("zeroOrderHold", ResamplingQuality::zeroOrderHold)
+        .value ("linear", ResamplingQuality::linear)
+        .value ("catmullRom", ResamplingQuality::catmullRom)
+        .value ("lagrange", ResamplingQuality::lagrange)
+        .value ("windowedSinc", ResamplingQuality::windowedSinc)
+        .export_values();
+
+    classAudioResampler
+        .def_static ("getNumOutputSamples", &AudioResampler::getNumOutputSamples, "numInputSamples"_a, "speedRatio"_a)
+        .def_static ("process", [](py::buffer source, py::buffer dest, double speedRatio, ResamplingQuality quality, int numThreads)
+        {
+            const auto sourceInfo = source.request();
+            const auto destInfo = dest.request (true);
+
+            int numSourceSamples = 0, numDestSamples = 0;
+            const auto sourceChannels = getBufferChannelPointers<const float> (sourceInfo, numSourceSamples);
+            const auto destChannels = getBufferChannelPointers<float> (destInfo, numDestSamples);
+
+            numDestSamples = jmin (numDestSamples, AudioResampler::getNumOutputSamples (numSourceSamples, speedRatio));
+
+            std::vector<AudioResampler::Job> jobs;
+            AudioResampler::addJobs (jobs, sourceChannels, numSourceSamples, destChannels, numDestSamples, speedRatio);
+
+            callReleasingGILForLargeSpans (destChannels.size() * static_cast<size_t> (numDestSamples), [&]
+            {
+                AudioResampler::process (jobs, quality, numThreads);
+            });
+
+            return numDestSamples;
+        }, "source"_a, "dest"_a, "speedRatio"_a, "quality"_a = ResamplingQuality::windowedSinc, "numThreads"_a = 0)
+        .def_static ("resample", [](py::buffer source, double speedRatio, ResamplingQuality quality, int numThreads)
+        {
+            const auto sourceInfo = source.request();
+
+            int numSourceSamples = 0;
+            const auto sourceChannels = getBufferChannelPointers<const float> (sourceInfo, numSourceSamples);
+
+            const auto numDestSamples = AudioResampler::getNumOutputSamples (numSourceSamples, speedRatio);
+            AudioBuffer<float> result (static_cast<int> (sourceChannels.size()), numDestSamples);
+
+            std::vector<AudioResampler::Job> jobs;
+            AudioResampler::addJobs (jobs, sourceChannels, numSourceSamples, getAudioBufferWritePointers (result), numDestSamples, speedRatio);
+
+            callReleasingGILForLargeSpans (sourceChannels.size() * static_cast<size_t> (numDestSamples), [&]
+            {
+                AudioResampler::process (jobs, quality, numThreads);
+            });
+
+            return result;
+        }, "source"_a, "speedRatio"_a, "quality"_a = ResamplingQuality::windowedSinc, "numThreads"_a = 0)
+        .def_static ("resampleBatch", [](py::list sources, py::object speedRatios, ResamplingQuality quality, int numThreads)
+        {
+            const auto hasSpeedRatioList = py::isinstance<py::sequence> (speedRatios);
+            if (hasSpeedRatioList && py::len (speedRatios) != sources.size())
+                py::pybind11_fail ("Resampling needs one speed ratio for each source");
+
+            std::vector<py::buffer_info> sourceInfos;
+            std::vector<AudioBuffer<float>> results;
+            std::vector<AudioResampler::Job> jobs;
+            size_t numTotalSamples = 0;
+
+            sourceInfos.reserve (sources.size());
+            results.reserve (sources.size());
+
+            for (size_t index = 0; index < sources.size(); ++index)
+            {
+                const auto speedRatio = (hasSpeedRatioList ? speedRatios[py::int_ (index)] : speedRatios).cast<double>();
+
+                sourceInfos.push_back (sources[index].cast<py::buffer>().request());
+
+                int numSourceSamples = 0;
+                const auto sourceChannels = getBufferChannelPointers<const float> (sourceInfos.back(), numSourceSamples);
+
+                const auto numDestSamples = AudioResampler::getNumOutputSamples (numSourceSamples, speedRatio);
+                auto& result = results.emplace_back (static_cast<int> (sourceChannels.size()), numDestSamples);
+
+                AudioResampler::addJobs (jobs, sourceChannels, numSourceSamples, getAudioBufferWritePointers (result), numDestSamples, speedRatio);
+                numTotalSamples += sourceChannels.size() * static_cast<size_t> (numDestSamples);
+            }
+
+            callReleasingGILForLargeSpans (numTotalSamples, [&]
+            {
+                AudioResampler::process (jobs, quality, numThreads);
+            });
+
+            py::list resampled;
+            for (auto& result : results)
+                resampled.append (py::cast (std::move (result)));
+
+            return resampled;
+        }, "sources"_a, "speedRatios"_a, "quality"_a = ResamplingQuality::windowedSinc, "numThreads"_a = 0)
+    ;
+
+    // ============================================================================================ popsicle::RenderAheadAudioSource
+
+    py::class_<RenderAheadAudioSource, AudioSource> classRenderAheadAudioSource (m, "RenderAheadAudioSource");
+
+    classRenderAheadAudioSource
+        .def (py::init<AudioSource*, int, int>(), "source"_a, "numBlocksAhead"_a = 4, "numChannels"_a = 2, py::keep_alive<1, 2>())
+        .def ("prepareToPlay", &RenderAheadAudioSource::prepareToPlay, "samplesPerBlockExpected"_a, "sampleRate"_a, py::call_guard<py::gil_scoped_release>())
+        .def ("releaseResources", &RenderAheadAudioSource::releaseResources, py::call_guard<py::gil_scoped_release>())
+        .def ("getNextAudioBlock", &RenderAheadAudioSource::getNextAudioBlock, "bufferToFill"_a, py::call_guard<py::gil_scoped_release>())
+        .def ("getNumBlocksAhead", &RenderAheadAudioSource::getNumBlocksAhead)
+        .def ("getNumChannels", &RenderAheadAudioSource::getNumChannels)
+        .def ("getLatencySamples", &RenderAheadAudioSource::getLatencySamples)
+        .def ("getLatencySeconds", &RenderAheadAudioSource::getLatencySeconds)
+        .def ("getNumReady", &RenderAheadAudioSource::getNumReady)
+        .def ("getNumUnderruns", &RenderAheadAudioSource::getNumUnderruns)
+        .def ("isRendering", &RenderAheadAudioSource::isRendering)
+        .def ("hasFailed", &RenderAheadAudioSource::hasFailed)
+    ;
+
+    // ============================================================================================ popsicle::AudioSourceGraph
+
+    py::class_<AudioSourceGraph, AudioSource> classAudioSourceGraph (m, "AudioSourceGraph");
+
+    classAudioSourceGraph
+        .def (py::init<const py::dict&, int>(), "description"_a, "maxPendingCommands"_a = 1024)
+        .def ("setParameter", &AudioSourceGraph::setParameter, "nodeId"_a, "parameter"_a, "value"_a)
+        .def ("getNodeIds", &AudioSourceGraph::getNodeIds)
+        .def ("hasNode", &AudioSourceGraph::hasNode, "nodeId"_a)
+        .def ("getNumNodes", &AudioSourceGraph::getNumNodes)
+        .def ("getNumPendingCommands", &AudioSourceGraph::getNumPendingCommands)
+        .def ("getNumDroppedCommands", &AudioSourceGraph::getNumDroppedCommands)
+    ;
+
     // ============================================================================================ juce::AudioPlayHead
 
     py::class_<AudioPlayHead, PyAudioPlayHead> classAudioPlayHead (m, "AudioPlayHead");
@@ -754,6 +3306,17 @@ void registerJuceAudioBasicsBindings (py::module_& m)
         .def ("transportRewind", &AudioPlayHead::transportRewind)
     ;
 
+    py::class_<CachedAudioPlayHead, AudioPlayHead> classCachedAudioPlayHead (m, "CachedAudioPlayHead");
+
+    classCachedAudioPlayHead
+        .def (py::init<>())
+        .def ("setPosition", &CachedAudioPlayHead::setPosition, "newPosition"_a)
+        .def ("setExtrapolation", &CachedAudioPlayHead::setExtrapolation, "shouldExtrapolate"_a, "sampleRate"_a)
+        .def ("isExtrapolating", &CachedAudioPlayHead::isExtrapolating)
+        .def ("getSampleRate", &CachedAudioPlayHead::getSampleRate)
+        .def ("getNumUpdates", &CachedAudioPlayHead::getNumUpdates)
+    ;
+
     // ============================================================================================ juce::Decibels
 
     py::class_<Decibels> classDecibels (m, "Decibels");
@@ -764,6 +3327,288 @@ void registerJuceAudioBasicsBindings (py::module_& m)
         .def_static ("gainWithLowerBound", &Decibels::template gainWithLowerBound<float>, "gain"_a, "lowerBoundDb"_a)
         .def_static ("toString", &Decibels::template toString<float>, "decibels"_a, "decimalPlaces"_a = 2, "minusInfinityDb"_a = -100.0f, "shouldIncludeSuffix"_a = true, "customMinusInfinityString"_a = String())
     ;
+
+    // ============================================================================================ juce::MidiMessage
+
+    py::class_<MidiMessage> classMidiMessage (m, "MidiMessage");
+
+    py::enum_<MidiMessage::SmpteTimecodeType> (classMidiMessage, "SmpteTimecodeType")
+        .value ("fps24", MidiMessage::SmpteTimecodeType::fps24)
+        .value ("fps25", MidiMessage::SmpteTimecodeType::fps25)
+        .value ("fps30drop", MidiMessage::SmpteTimecodeType::fps30drop)
+        .value ("fps30", MidiMessage::SmpteTimecodeType::fps30)
+        .export_values();
+
+    py::enum_<MidiMessage::MidiMachineControlCommand> (classMidiMessage, "MidiMachineControlCommand")
+        .value ("mmc_stop", MidiMessage::MidiMachineControlCommand::mmc_stop)
+        .value ("mmc_play", MidiMessage::MidiMachineControlCommand::mmc_play)
+        .value ("mmc_deferredplay", MidiMessage::MidiMachineControlCommand::mmc_deferredplay)
+        .value ("mmc_fastforward", MidiMessage::MidiMachineControlCommand::mmc_fastforward)
+        .value ("mmc_rewind", MidiMessage::MidiMachineControlCommand::mmc_rewind)
+        .value ("mmc_recordStart", MidiMessage::MidiMachineControlCommand::mmc_recordStart)
+        .value ("mmc_recordStop", MidiMessage::MidiMachineControlCommand::mmc_recordStop)
+        .value ("mmc_pause", MidiMessage::MidiMachineControlCommand::mmc_pause)
+        .export_values();
+
+    classMidiMessage
+        .def (py::init<>())
+        .def (py::init<int, int, int, double>(), "byte1"_a, "byte2"_a, "byte3"_a, "timeStamp"_a = 0.0)
+        .def (py::init<int, int, double>(), "byte1"_a, "byte2"_a, "timeStamp"_a = 0.0)
+        .def (py::init<int, double>(), "byte1"_a, "timeStamp"_a = 0.0)
+        .def (py::init ([](py::buffer data, double timeStamp)
+        {
+            const auto info = getContiguousBufferInfo (data, false);
+            return MidiMessage (info.ptr, static_cast<int> (getBufferSizeInBytes (info)), timeStamp);
+        }), "data"_a, "timeStamp"_a = 0.0)
+        .def (py::init<const MidiMessage&, double>(), "other"_a, "newTimeStamp"_a)
+        .def (py::init<const MidiMessage&>())
+        .def ("getRawData", [](const MidiMessage& self)
+        {
+            return py::bytes (reinterpret_cast<const char*> (self.getRawData()), static_cast<size_t> (self.getRawDataSize()));
+        })
+        .def ("getRawDataSize", &MidiMessage::getRawDataSize)
+        .def ("getDescription", &MidiMessage::getDescription)
+        .def ("getTimeStamp", &MidiMessage::getTimeStamp)
+        .def ("setTimeStamp", &MidiMessage::setTimeStamp, "newTimestamp"_a)
+        .def ("addToTimeStamp", &MidiMessage::addToTimeStamp, "delta"_a)
+        .def ("withTimeStamp", &MidiMessage::withTimeStamp, "newTimestamp"_a)
+        .def ("getChannel", &MidiMessage::getChannel)
+        .def ("isForChannel", &MidiMessage::isForChannel, "channelNumber"_a)
+        .def ("setChannel", &MidiMessage::setChannel, "newChannelNumber"_a)
+        .def ("isSysEx", &MidiMessage::isSysEx)
+        .def ("getSysExData", [](const MidiMessage& self)
+        {
+            return py::bytes (reinterpret_cast<const char*> (self.getSysExData()), static_cast<size_t> (self.getSysExDataSize()));
+        })
+        .def ("getSysExDataSize", &MidiMessage::getSysExDataSize)
+        .def ("isNoteOnOrOff", &MidiMessage::isNoteOnOrOff)
+        .def ("isNoteOn", &MidiMessage::isNoteOn, "returnTrueForVelocity0"_a = false)
+        .def ("isNoteOff", &MidiMessage::isNoteOff, "returnTrueForNoteOnVelocity0"_a = true)
+        .def ("getNoteNumber", &MidiMessage::getNoteNumber)
+        .def ("setNoteNumber", &MidiMessage::setNoteNumber, "newNoteNumber"_a)
+        .def ("getVelocity", &MidiMessage::getVelocity)
+        .def ("getFloatVelocity", &MidiMessage::getFloatVelocity)
+        .def ("setVelocity", &MidiMessage::setVelocity, "newVelocity"_a)
+        .def ("multiplyVelocity", &MidiMessage::multiplyVelocity, "scaleFactor"_a)
+        .def ("isSustainPedalOn", &MidiMessage::isSustainPedalOn)
+        .def ("isSustainPedalOff", &MidiMessage::isSustainPedalOff)
+        .def ("isSostenutoPedalOn", &MidiMessage::isSostenutoPedalOn)
+        .def ("isSostenutoPedalOff", &MidiMessage::isSostenutoPedalOff)
+        .def ("isSoftPedalOn", &MidiMessage::isSoftPedalOn)
+        .def ("isSoftPedalOff", &MidiMessage::isSoftPedalOff)
+        .def ("isProgramChange", &MidiMessage::isProgramChange)
+        .def ("getProgramChangeNumber", &MidiMessage::getProgramChangeNumber)
+        .def ("isPitchWheel", &MidiMessage::isPitchWheel)
+        .def ("getPitchWheelValue", &MidiMessage::getPitchWheelValue)
+        .def ("isAftertouch", &MidiMessage::isAftertouch)
+        .def ("getAfterTouchValue", &MidiMessage::getAfterTouchValue)
+        .def ("isChannelPressure", &MidiMessage::isChannelPressure)
+        .def ("getChannelPressureValue", &MidiMessage::getChannelPressureValue)
+        .def ("isController", &MidiMessage::isController)
+        .def ("getControllerNumber", &MidiMessage::getControllerNumber)
+        .def ("getControllerValue", &MidiMessage::getControllerValue)
+        .def ("isControllerOfType", &MidiMessage::isControllerOfType, "controllerType"_a)
+        .def ("isAllNotesOff", &MidiMessage::isAllNotesOff)
+        .def ("isAllSoundOff", &MidiMessage::isAllSoundOff)
+        .def ("isResetAllControllers", &MidiMessage::isResetAllControllers)
+        .def ("isMetaEvent", &MidiMessage::isMetaEvent)
+        .def ("getMetaEventType", &MidiMessage::getMetaEventType)
+        .def ("getMetaEventData", [](const MidiMessage& self)
+        {
+            return py::bytes (reinterpret_cast<const char*> (self.getMetaEventData()), static_cast<size_t> (self.getMetaEventLength()));
+        })
+        .def ("getMetaEventLength", &MidiMessage::getMetaEventLength)
+        .def ("isTrackMetaEvent", &MidiMessage::isTrackMetaEvent)
+        .def ("isEndOfTrackMetaEvent", &MidiMessage::isEndOfTrackMetaEvent)
+        .def ("isTextMetaEvent", &MidiMessage::isTextMetaEvent)
+        .def ("getTextFromTextMetaEvent", &MidiMessage::getTextFromTextMetaEvent)
+        .def ("isTrackNameEvent", &MidiMessage::isTrackNameEvent)
+        .def ("isTempoMetaEvent", &MidiMessage::isTempoMetaEvent)
+        .def ("getTempoMetaEventTickLength", &MidiMessage::getTempoMetaEventTickLength, "timeFormat"_a)
+        .def ("getTempoSecondsPerQuarterNote", &MidiMessage::getTempoSecondsPerQuarterNote)
+        .def ("isTimeSignatureMetaEvent", &MidiMessage::isTimeSignatureMetaEvent)
+        .def ("getTimeSignatureInfo", [](const MidiMessage& self)
+        {
+            int numerator = 0, denominator = 0;
+            self.getTimeSignatureInfo (numerator, denominator);
+            return py::make_tuple (numerator, denominator);
+        })
+        .def ("isKeySignatureMetaEvent", &MidiMessage::isKeySignatureMetaEvent)
+        .def ("getKeySignatureNumberOfSharpsOrFlats", &MidiMessage::getKeySignatureNumberOfSharpsOrFlats)
+        .def ("isKeySignatureMajorKey", &MidiMessage::isKeySignatureMajorKey)
+        .def ("isMidiChannelMetaEvent", &MidiMessage::isMidiChannelMetaEvent)
+        .def ("getMidiChannelMetaEventChannel", &MidiMessage::getMidiChannelMetaEventChannel)
+        .def ("isActiveSense", &MidiMessage::isActiveSense)
+        .def ("isMidiStart", &MidiMessage::isMidiStart)
+        .def ("isMidiContinue", &MidiMessage::isMidiContinue)
+        .def ("isMidiStop", &MidiMessage::isMidiStop)
+        .def ("isMidiClock", &MidiMessage::isMidiClock)
+        .def ("isSongPositionPointer", &MidiMessage::isSongPositionPointer)
+        .def ("getSongPositionPointerMidiBeat", &MidiMessage::getSongPositionPointerMidiBeat)
+        .def ("isQuarterFrame", &MidiMessage::isQuarterFrame)
+        .def ("getQuarterFrameSequenceNumber", &MidiMessage::getQuarterFrameSequenceNumber)
+        .def ("getQuarterFrameValue", &MidiMessage::getQuarterFrameValue)
+        .def ("isFullFrame", &MidiMessage::isFullFrame)
+        .def ("isMidiMachineControlMessage", &MidiMessage::isMidiMachineControlMessage)
+        .def_static ("noteOn", py::overload_cast<int, int, float> (&MidiMessage::noteOn), "channel"_a, "noteNumber"_a, "velocity"_a)
+        .def_static ("noteOn", py::overload_cast<int, int, uint8> (&MidiMessage::noteOn), "channel"_a, "noteNumber"_a, "velocity"_a)
+        .def_static ("noteOff", py::overload_cast<int, int, float> (&MidiMessage::noteOff), "channel"_a, "noteNumber"_a, "velocity"_a)
+        .def_static ("noteOff", py::overload_cast<int, int, uint8> (&MidiMessage::noteOff), "channel"_a, "noteNumber"_a, "velocity"_a)
+        .def_static ("noteOff", py::overload_cast<int, int> (&MidiMessage::noteOff), "channel"_a, "noteNumber"_a)
+        .def_static ("programChange", &MidiMessage::programChange, "channel"_a, "programNumber"_a)
+        .def_static ("pitchWheel", &MidiMessage::pitchWheel, "channel"_a, "position"_a)
+        .def_static ("aftertouchChange", &MidiMessage::aftertouchChange, "channel"_a, "noteNumber"_a, "aftertouchAmount"_a)
+        .def_static ("channelPressureChange", &MidiMessage::channelPressureChange, "channel"_a, "pressure"_a)
+        .def_static ("controllerEvent", &MidiMessage::controllerEvent, "channel"_a, "controllerType"_a, "value"_a)
+        .def_static ("allNotesOff", &MidiMessage::allNotesOff, "channel"_a)
+        .def_static ("allSoundOff", &MidiMessage::allSoundOff, "channel"_a)
+        .def_static ("allControllersOff", &MidiMessage::allControllersOff, "channel"_a)
+        .def_static ("textMetaEvent", &MidiMessage::textMetaEvent, "type"_a, "text"_a)
+        .def_static ("tempoMetaEvent", &MidiMessage::tempoMetaEvent, "microsecondsPerQuarterNote"_a)
+        .def_static ("timeSignatureMetaEvent", &MidiMessage::timeSignatureMetaEvent, "numerator"_a, "denominator"_a)
+        .def_static ("keySignatureMetaEvent", &MidiMessage::keySignatureMetaEvent, "numberOfSharpsOrFlats"_a, "isMinorKey"_a)
+        .def_static ("midiChannelMetaEvent", &MidiMessage::midiChannelMetaEvent, "channel"_a)
+        .def_static ("endOfTrack", &MidiMessage::endOfTrack)
+        .def_static ("midiStart", &MidiMessage::midiStart)
+        .def_static ("midiContinue", &MidiMessage::midiContinue)
+        .def_static ("midiStop", &MidiMessage::midiStop)
+        .def_static ("midiClock", &MidiMessage::midiClock)
+        .def_static ("songPositionPointer", &MidiMessage::songPositionPointer, "positionInMidiBeats"_a)
+        .def_static ("quarterFrame", &MidiMessage::quarterFrame, "sequenceNumber"_a, "value"_a)
+        .def_static ("fullFrame", &MidiMessage::fullFrame, "hours"_a, "minutes"_a, "seconds"_a, "frames"_a, "timecodeType"_a)
+        .def_static ("midiMachineControlCommand", &MidiMessage::midiMachineControlCommand, "command"_a)
+        .def_static ("masterVolume", &MidiMessage::masterVolume, "volume"_a)
+        .def_static ("createSysExMessage", [](py::buffer data)
+        {
+            const auto info = getContiguousBufferInfo (data, false);
+            return MidiMessage::createSysExMessage (info.ptr, static_cast<int> (getBufferSizeInBytes (info)));
+        }, "data"_a)
+        .def_static ("getMidiNoteName", &MidiMessage::getMidiNoteName, "noteNumber"_a, "useSharps"_a = true, "includeOctaveNumber"_a = true, "octaveNumForMiddleC"_a = 3)
+        .def_static ("getMidiNoteInHertz", &MidiMessage::getMidiNoteInHertz, "noteNumber"_a, "frequencyOfA"_a = 440.0)
+        .def_static ("isMidiNoteBlack", &MidiMessage::isMidiNoteBlack, "noteNumber"_a)
+        .def_static ("getGMInstrumentName", &MidiMessage::getGMInstrumentName, "midiInstrumentNumber"_a)
+        .def_static ("getControllerName", &MidiMessage::getControllerName, "controllerNumber"_a)
+        .def_static ("getMessageLengthFromFirstByte", &MidiMessage::getMessageLengthFromFirstByte, "firstByte"_a)
+        .def_static ("floatValueToMidiByte", &MidiMessage::floatValueToMidiByte, "valueBetween0and1"_a)
+        .def_static ("pitchbendToPitchwheelPos", &MidiMessage::pitchbendToPitchwheelPos, "pitchbendInSemitones"_a, "pitchbendRangeInSemitones"_a)
+        .def ("__repr__", [](const MidiMessage& self)
+        {
+            String result;
+            result
+                << Helpers::pythonizeModuleClassName (PythonModuleName, typeid (self).name())
+                << "('" << self.getDescription() << "', " << self.getTimeStamp() << ")";
+            return result;
+        })
+    ;
+
+    // ============================================================================================ popsicle::MidiEventArray
+
+    registerRecordArray<MidiEventRecord> (m, "MidiEventArray");
+
+    // ============================================================================================ juce::MidiBuffer
+
+    py::class_<MidiBuffer> classMidiBuffer (m, "MidiBuffer");
+
+    classMidiBuffer
+        .def (py::init<>())
+        .def (py::init<const MidiMessage&>(), "message"_a)
+        .def (py::init<const MidiBuffer&>())
+        .def ("clear", py::overload_cast<> (&MidiBuffer::clear))
+        .def ("clear", py::overload_cast<int, int> (&MidiBuffer::clear), "start"_a, "numSamples"_a)
+        .def ("isEmpty", &MidiBuffer::isEmpty)
+        .def ("getNumEvents", &MidiBuffer::getNumEvents)
+        .def ("addEvent", py::overload_cast<const MidiMessage&, int> (&MidiBuffer::addEvent), "midiMessage"_a, "sampleNumber"_a)
+        .def ("addEvent", [](MidiBuffer& self, py::buffer rawMidiData, int sampleNumber)
+        {
+            const auto info = getContiguousBufferInfo (rawMidiData, false);
+            return self.addEvent (info.ptr, static_cast<int> (getBufferSizeInBytes (info)), sampleNumber);
+        }, "rawMidiData"_a, "sampleNumber"_a)
+        .def ("addEvents", py::overload_cast<const MidiBuffer&, int, int, int> (&MidiBuffer::addEvents), "otherBuffer"_a, "startSample"_a, "numSamples"_a, "sampleDeltaToAdd"_a)
+        .def ("addEvents", &addMidiEvents, "events"_a, "sysexData"_a = py::none(), "sampleDeltaToAdd"_a = 0)
+        .def ("exportEvents", &exportMidiEvents, "startSample"_a = 0, "numSamples"_a = -1)
+        .def_static ("fromEvents", [](py::buffer events, py::object sysexData)
+        {
+            MidiBuffer result;
+            addMidiEvents (result, std::move (events), std::move (sysexData), 0);
+            return result;
+        }, "events"_a, "sysexData"_a = py::none())
+        .def ("getFirstEventTime", &MidiBuffer::getFirstEventTime)
+        .def ("getLastEventTime", &MidiBuffer::getLastEventTime)
+        .def ("swapWith", &MidiBuffer::swapWith, "other"_a)
+        .def ("ensureSize", &MidiBuffer::ensureSize, "minimumNumBytes"_a)
+        .def ("__len__", &MidiBuffer::getNumEvents)
+        .def ("__iter__", [](const MidiBuffer& self)
+        {
+            py::list events;
+
+            for (const auto metadata : self)
+                events.append (py::make_tuple (metadata.getMessage(), metadata.samplePosition));
+
+            return py::iter (events);
+        })
+    ;
+
+    // ============================================================================================ juce::MidiFile
+
+    registerRecordArray<MidiFileEventRecord> (m, "MidiFileEventArray");
+
+    py::class_<MidiFile> classMidiFile (m, "MidiFile");
+
+    classMidiFile
+        .def (py::init<>())
+        .def (py::init<const MidiFile&>())
+        .def ("getNumTracks", &MidiFile::getNumTracks)
+        .def ("clear", &MidiFile::clear)
+        .def ("getTimeFormat", &MidiFile::getTimeFormat)
+        .def ("setTicksPerQuarterNote", &MidiFile::setTicksPerQuarterNote, "ticksPerQuarterNote"_a)
+        .def ("setSmpteTimeFormat", &MidiFile::setSmpteTimeFormat, "framesPerSecond"_a, "subframeResolution"_a)
+        .def ("getLastTimestamp", &MidiFile::getLastTimestamp)
+        .def ("convertTimestampTicksToSeconds", &MidiFile::convertTimestampTicksToSeconds)
+        .def ("readFrom", [](MidiFile& self, InputStream& sourceStream, bool createMatchingNoteOffs)
+        {
+            return self.readFrom (sourceStream, createMatchingNoteOffs);
+        }, "sourceStream"_a, "createMatchingNoteOffs"_a = true)
+        .def ("writeTo", &MidiFile::writeTo, "destStream"_a, "midiFileType"_a = 1)
+        .def_static ("parseToArrays", [](py::object source, bool createMatchingNoteOffs)
+        {
+            const MidiFileSource midiFileSource (source);
+
+            ParsedMidiFile parsed;
+            {
+                py::gil_scoped_release release;
+                parsed = midiFileSource.parse (createMatchingNoteOffs);
+            }
+
+            if (! parsed.wasParsed)
+                py::pybind11_fail ("Unable to parse the midi file");
+
+            return createMidiFileArrays (std::move (parsed));
+        }, "source"_a, "createMatchingNoteOffs"_a = true)
+        .def_static ("parseBatchToArrays", [](py::list sources, bool createMatchingNoteOffs, int numThreads)
+        {
+            std::vector<MidiFileSource> midiFileSources;
+            midiFileSources.reserve (sources.size());
+
+            for (const auto& source : sources)
+                midiFileSources.emplace_back (source);
+
+            std::vector<ParsedMidiFile> parsed (midiFileSources.size());
+            {
+                py::gil_scoped_release release;
+
+                parallelFor ("MidiFileParser", midiFileSources.size(), numThreads, [&] (size_t index)
+                {
+                    parsed[index] = midiFileSources[index].parse (createMatchingNoteOffs);
+                });
+            }
+
+            py::list results;
+            for (auto& parsedFile : parsed)
+                results.append (createMidiFileArrays (std::move (parsedFile)));
+
+            return results;
+        }, "sources"_a, "createMatchingNoteOffs"_a = true, "numThreads"_a = 0)
+    ;
 }
 
 } // namespace popsicle::Bindings
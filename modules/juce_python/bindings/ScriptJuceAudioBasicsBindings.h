@@ -36,6 +36,13 @@ void registerJuceAudioBasicsBindings (pybind11::module_& m);
 
 // =================================================================================================
 
+/**
+ * @brief Number of values above which bulk operations on array data release the GIL while running.
+ */
+inline constexpr size_t minimumValuesToReleaseGIL = 4096;
+
+// =================================================================================================
+
 template <class T>
 struct PyArrayView
 {
@@ -63,6 +70,12 @@ struct PyArrayView
         return numValues;
     }
 
+    void setData (T* newValues, size_t newNumValues) noexcept
+    {
+        values = newValues;
+        numValues = newNumValues;
+    }
+
 private:
     T* values = nullptr;
     size_t numValues = 0;
@@ -70,6 +83,988 @@ private:
 
 // =================================================================================================
 
+/**
+ * @brief Returns the distance in samples between consecutive channels of an AudioBuffer.
+ *
+ * Owned buffers always lay out their channels in a single allocation, but buffers referring to external data
+ * might not: in that case there is no uniform stride and an empty optional is returned.
+ */
+template <class T>
+std::optional<std::ptrdiff_t> getChannelStride (const juce::AudioBuffer<T>& buffer) noexcept
+{
+    const auto numChannels = buffer.getNumChannels();
+    if (numChannels <= 1)
+        return static_cast<std::ptrdiff_t> (buffer.getNumSamples());
+
+    const auto channels = buffer.getArrayOfReadPointers();
+    const auto channelAddress = [&](int channel) { return static_cast<std::ptrdiff_t> (reinterpret_cast<std::uintptr_t> (channels[channel])); };
+
+    const auto strideInBytes = channelAddress (1) - channelAddress (0);
+    if (strideInBytes % static_cast<std::ptrdiff_t> (sizeof (T)) != 0)
+        return std::nullopt;
+
+    for (int channel = 2; channel < numChannels; ++channel)
+    {
+        if (channelAddress (channel) - channelAddress (channel - 1) != strideInBytes)
+            return std::nullopt;
+    }
+
+    return strideInBytes / static_cast<std::ptrdiff_t> (sizeof (T));
+}
+
+// =================================================================================================
+
+/**
+ * @brief Checks if a python buffer holds values of the specified type in native byte order.
+ */
+template <class T>
+bool isBufferOfType (const pybind11::buffer_info& info)
+{
+    if (info.item_type_is_equivalent_to<T>())
+        return true;
+
+    if (info.itemsize != static_cast<pybind11::ssize_t> (sizeof (T)) || info.format.size() != 2)
+        return false;
+
+    const auto byteOrder = info.format[0];
+    const auto nativeByteOrder = juce::ByteOrder::isBigEndian() ? '>' : '<';
+
+    return (byteOrder == '@' || byteOrder == '=' || byteOrder == nativeByteOrder)
+        && info.format.substr (1) == pybind11::format_descriptor<T>::format();
+}
+
+/**
+ * @brief Collects the channel pointers of a python buffer shaped as (channels, samples), or as a single channel.
+ *
+ * Samples must be contiguous inside each channel, while channels can be placed at any distance from each other.
+ */
+template <class T>
+std::vector<T*> getBufferChannelPointers (const pybind11::buffer_info& info, int& numSamples)
+{
+    using ValueType = std::remove_const_t<T>;
+
+    constexpr auto itemSize = static_cast<pybind11::ssize_t> (sizeof (ValueType));
+
+    if (! isBufferOfType<ValueType> (info))
+        pybind11::pybind11_fail ("Buffer data type doesn't match the expected sample type");
+
+    if (info.ndim < 1 || info.ndim > 2)
+        pybind11::pybind11_fail ("Buffer must be shaped as (samples) or (channels, samples)");
+
+    const auto samplesAxis = static_cast<size_t> (info.ndim - 1);
+    if (info.shape[samplesAxis] > std::numeric_limits<int>::max())
+        pybind11::pybind11_fail ("Buffer contains too many samples");
+
+    if (info.shape[samplesAxis] > 1 && info.strides[samplesAxis] != itemSize)
+        pybind11::pybind11_fail ("Buffer samples must be contiguous inside each channel");
+
+    numSamples = static_cast<int> (info.shape[samplesAxis]);
+
+    auto data = static_cast<std::conditional_t<std::is_const_v<T>, const char*, char*>> (info.ptr);
+
+    if (info.ndim == 1)
+        return { reinterpret_cast<T*> (data) };
+
+    if (info.strides[0] % itemSize != 0)
+        pybind11::pybind11_fail ("Buffer channels must be aligned to the sample size");
+
+    std::vector<T*> channels (static_cast<size_t> (info.shape[0]));
+
+    for (size_t channel = 0; channel < channels.size(); ++channel)
+        channels[channel] = reinterpret_cast<T*> (data + static_cast<pybind11::ssize_t> (channel) * info.strides[0]);
+
+    return channels;
+}
+
+// =================================================================================================
+
+/**
+ * @brief Runs a function for each index in [0, numJobs) on a temporary ThreadPool, waiting for all of them to finish.
+ *
+ * A number of threads less or equal to zero uses one thread per cpu, while a single thread runs the jobs in place.
+ */
+template <class F>
+void parallelFor (const juce::String& threadName, size_t numJobs, int numThreads, F&& function)
+{
+    if (numThreads <= 0)
+        numThreads = juce::SystemStats::getNumCpus();
+
+    numThreads = static_cast<int> (juce::jmin (static_cast<size_t> (numThreads), numJobs));
+
+    if (numThreads <= 1)
+    {
+        for (size_t index = 0; index < numJobs; ++index)
+            function (index);
+
+        return;
+    }
+
+    juce::WaitableEvent finished;
+    std::atomic<size_t> numPendingJobs { numJobs };
+
+    juce::ThreadPool pool (juce::ThreadPoolOptions{}
+        .withThreadName (threadName)
+        .withNumberOfThreads (numThreads));
+
+    for (size_t index = 0; index < numJobs; ++index)
+    {
+        pool.addJob ([&, index]
+        {
+            function (index);
+
+            if (--numPendingJobs == 0)
+                finished.signal();
+        });
+    }
+
+    finished.wait();
+}
+
+// =================================================================================================
+
+enum class ResamplingQuality
+{
+    zeroOrderHold,
+    linear,
+    catmullRom,
+    lagrange,
+    windowedSinc
+};
+
+/**
+ * @brief Resamples whole channels offline with the JUCE interpolators, spreading the channels over a thread pool.
+ *
+ * The algorithmic latency of the interpolators is compensated so the first output sample lines up with the first input
+ * sample, while the end of the input is padded with silence. The speed ratio is the number of input samples consumed for
+ * each output sample, as in ResamplingAudioSource.
+ */
+struct AudioResampler
+{
+    struct Job
+    {
+        const float* source = nullptr;
+        int numSourceSamples = 0;
+        float* dest = nullptr;
+        int numDestSamples = 0;
+        double speedRatio = 1.0;
+    };
+
+    static int getNumOutputSamples (int numInputSamples, double speedRatio)
+    {
+        if (! (speedRatio > 0.0) || ! std::isfinite (speedRatio))
+            pybind11::pybind11_fail ("Resampling speed ratio must be a positive number");
+
+        // Ratios computed from sample rates are rarely exact, so tolerate a tiny rounding error before rounding up
+        const auto numOutputSamples = std::ceil (static_cast<double> (juce::jmax (0, numInputSamples)) / speedRatio - 1.0e-6);
+        if (numOutputSamples > static_cast<double> (std::numeric_limits<int>::max()))
+            pybind11::pybind11_fail ("Resampled buffer would contain too many samples");
+
+        return static_cast<int> (numOutputSamples);
+    }
+
+    static void addJobs (std::vector<Job>& jobs, const std::vector<const float*>& sourceChannels, int numSourceSamples,
+                         const std::vector<float*>& destChannels, int numDestSamples, double speedRatio)
+    {
+        if (sourceChannels.size() != destChannels.size())
+            pybind11::pybind11_fail ("Resampling source and destination must have the same number of channels");
+
+        for (size_t channel = 0; channel < sourceChannels.size(); ++channel)
+            jobs.push_back ({ sourceChannels[channel], numSourceSamples, destChannels[channel], numDestSamples, speedRatio });
+    }
+
+    static void process (const std::vector<Job>& jobs, ResamplingQuality quality, int numThreads)
+    {
+        parallelFor ("AudioResampler", jobs.size(), numThreads, [&] (size_t index)
+        {
+            processJob (jobs[index], quality);
+        });
+    }
+
+private:
+    static void processJob (const Job& job, ResamplingQuality quality)
+    {
+        switch (quality)
+        {
+            case ResamplingQuality::zeroOrderHold: resampleChannel<juce::ZeroOrderHoldInterpolator> (job); break;
+            case ResamplingQuality::linear: resampleChannel<juce::LinearInterpolator> (job); break;
+            case ResamplingQuality::catmullRom: resampleChannel<juce::CatmullRomInterpolator> (job); break;
+            case ResamplingQuality::lagrange: resampleChannel<juce::LagrangeInterpolator> (job); break;
+            case ResamplingQuality::windowedSinc: resampleChannel<juce::WindowedSincInterpolator> (job); break;
+        }
+    }
+
+    template <class Interpolator>
+    static void resampleChannel (const Job& job)
+    {
+        Interpolator interpolator;
+
+        const auto latency = juce::roundToInt (Interpolator::getBaseLatency());
+
+        auto source = job.source;
+        auto numAvailable = job.numSourceSamples;
+        std::vector<float> paddedTail;
+
+        const auto render = [&] (double speedRatio, float* dest, int numSamples)
+        {
+            while (numSamples > 0)
+            {
+                // The interpolator pushes up to one position ahead of the sample it produces, keep away from the end
+                const auto numSafe = paddedTail.empty()
+                    ? static_cast<int> (std::floor ((numAvailable - 2) / speedRatio)) - 1
+                    : numSamples;
+
+                if (numSafe <= 0)
+                {
+                    paddedTail.assign (source, source + numAvailable);
+                    paddedTail.resize (paddedTail.size() + static_cast<size_t> (latency + std::ceil (juce::jmax (1.0, job.speedRatio)) + 8), 0.0f);
+
+                    source = paddedTail.data();
+                    numAvailable = static_cast<int> (paddedTail.size());
+                    continue;
+                }
+
+                const auto numToRender = juce::jmin (numSafe, numSamples);
+                const auto numUsed = interpolator.process (speedRatio, source, dest, numToRender);
+
+                source += numUsed;
+                numAvailable -= numUsed;
+                dest += numToRender;
+                numSamples -= numToRender;
+
+                jassert (numAvailable >= 0);
+            }
+        };
+
+        std::vector<float> discarded (static_cast<size_t> (latency));
+        render (1.0, discarded.data(), latency);
+        render (job.speedRatio, job.dest, job.numDestSamples);
+    }
+};
+
+// =================================================================================================
+
+/**
+ * @brief Sample formats of raw PCM data that can be converted to and from AudioBuffer channels.
+ */
+enum class PCMSampleFormat
+{
+    int8,
+    uint8,
+    int16,
+    int24,
+    int32,
+    float32
+};
+
+/**
+ * @brief Byte order of raw PCM data.
+ */
+enum class PCMEndianness
+{
+    littleEndian,
+    bigEndian
+};
+
+// =================================================================================================
+
+/**
+ * @brief Lock-free allocator of a fixed number of slots, used to hand out pre-allocated objects on real time threads.
+ *
+ * Preparing the allocator is not real time safe, while acquiring and releasing slots never locks or allocates.
+ */
+class PoolSlotAllocator
+{
+public:
+    PoolSlotAllocator() = default;
+
+    /** Resizes the allocator, marking all the slots as available. */
+    void prepare (int newNumSlots)
+    {
+        numSlots = juce::jmax (0, newNumSlots);
+        slotsInUse = std::make_unique<std::atomic<bool>[]> (static_cast<size_t> (numSlots));
+
+        for (int index = 0; index < numSlots; ++index)
+            slotsInUse[static_cast<size_t> (index)].store (false, std::memory_order_relaxed);
+
+        numInUse.store (0, std::memory_order_relaxed);
+        resetStatistics();
+    }
+
+    /** Acquires a free slot, returning its index or -1 if all the slots are in use. */
+    int acquire() noexcept
+    {
+        for (int index = 0; index < numSlots; ++index)
+        {
+            bool expected = false;
+            if (slotsInUse[static_cast<size_t> (index)].compare_exchange_strong (expected, true, std::memory_order_acquire))
+            {
+                const auto currentlyInUse = numInUse.fetch_add (1, std::memory_order_relaxed) + 1;
+
+                auto previousHighWaterMark = highWaterMark.load (std::memory_order_relaxed);
+                while (currentlyInUse > previousHighWaterMark
+                       && ! highWaterMark.compare_exchange_weak (previousHighWaterMark, currentlyInUse, std::memory_order_relaxed))
+                {
+                }
+
+                return index;
+            }
+        }
+
+        numFailedAcquires.fetch_add (1, std::memory_order_relaxed);
+        return -1;
+    }
+
+    /** Releases a previously acquired slot, returns false if the slot wasn't in use. */
+    bool release (int index) noexcept
+    {
+        if (! juce::isPositiveAndBelow (index, numSlots))
+            return false;
+
+        if (! slotsInUse[static_cast<size_t> (index)].exchange (false, std::memory_order_release))
+            return false;
+
+        numInUse.fetch_sub (1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool isInUse (int index) const noexcept
+    {
+        return juce::isPositiveAndBelow (index, numSlots)
+            && slotsInUse[static_cast<size_t> (index)].load (std::memory_order_acquire);
+    }
+
+    int getNumSlots() const noexcept { return numSlots; }
+    int getNumInUse() const noexcept { return numInUse.load (std::memory_order_relaxed); }
+    int getNumAvailable() const noexcept { return numSlots - getNumInUse(); }
+    int getHighWaterMark() const noexcept { return highWaterMark.load (std::memory_order_relaxed); }
+    juce::int64 getNumFailedAcquires() const noexcept { return numFailedAcquires.load (std::memory_order_relaxed); }
+
+    /** Resets the high water mark to the number of slots currently in use, and clears the failed acquires count. */
+    void resetStatistics() noexcept
+    {
+        highWaterMark.store (getNumInUse(), std::memory_order_relaxed);
+        numFailedAcquires.store (0, std::memory_order_relaxed);
+    }
+
+private:
+    std::unique_ptr<std::atomic<bool>[]> slotsInUse;
+    int numSlots = 0;
+
+    std::atomic<int> numInUse { 0 };
+    std::atomic<int> highWaterMark { 0 };
+    std::atomic<juce::int64> numFailedAcquires { 0 };
+};
+
+// =================================================================================================
+
+/**
+ * @brief Single producer, single consumer lock-free FIFO of multi-channel float samples.
+ *
+ * Channels are stored in a single planar block, so each of the two regions returned when preparing a read or a write
+ * is addressable as a (channels, samples) strided array. Overruns and underruns are counted whenever a write or a read
+ * can't be fully satisfied.
+ */
+class AudioFifo
+{
+public:
+    AudioFifo (int numChannelsToAllocate, int capacity)
+        : numChannels (juce::jmax (1, numChannelsToAllocate))
+        , fifo (juce::jmax (1, capacity) + 1)
+        , storage (static_cast<size_t> (numChannels) * static_cast<size_t> (fifo.getTotalSize()), 0.0f)
+    {
+    }
+
+    int getNumChannels() const noexcept { return numChannels; }
+    int getCapacity() const noexcept { return fifo.getTotalSize() - 1; }
+    int getNumReady() const noexcept { return fifo.getNumReady(); }
+    int getFreeSpace() const noexcept { return fifo.getFreeSpace(); }
+
+    /** Returns the distance in samples between the same sample index of two consecutive channels. */
+    int getChannelStride() const noexcept { return fifo.getTotalSize(); }
+
+    float* getChannelData (int channel, int index) noexcept
+    {
+        return storage.data() + static_cast<size_t> (channel) * static_cast<size_t> (getChannelStride()) + static_cast<size_t> (index);
+    }
+
+    /** Writes samples from the channel pointers, missing channels are filled with silence. Returns the number of samples written. */
+    int write (const float* const* channels, int numSourceChannels, int numSamples) noexcept
+    {
+        const auto scope = fifo.write (juce::jmax (0, numSamples));
+        const auto numWritten = scope.blockSize1 + scope.blockSize2;
+
+        if (numWritten < numSamples)
+            numOverruns.fetch_add (1, std::memory_order_relaxed);
+
+        copyToStorage (channels, numSourceChannels, 0, scope.startIndex1, scope.blockSize1);
+        copyToStorage (channels, numSourceChannels, scope.blockSize1, scope.startIndex2, scope.blockSize2);
+
+        return numWritten;
+    }
+
+    /** Reads samples into the channel pointers, clearing what couldn't be read. Returns the number of samples read. */
+    int read (float* const* channels, int numDestChannels, int numSamples) noexcept
+    {
+        numSamples = juce::jmax (0, numSamples);
+
+        const auto scope = fifo.read (numSamples);
+        const auto numRead = scope.blockSize1 + scope.blockSize2;
+
+        copyFromStorage (channels, numDestChannels, 0, scope.startIndex1, scope.blockSize1);
+        copyFromStorage (channels, numDestChannels, scope.blockSize1, scope.startIndex2, scope.blockSize2);
+
+        if (numRead < numSamples)
+        {
+            numUnderruns.fetch_add (1, std::memory_order_relaxed);
+
+            for (int channel = 0; channel < numDestChannels; ++channel)
+            {
+                if (channels[channel] != nullptr)
+                    juce::FloatVectorOperations::clear (channels[channel] + numRead, numSamples - numRead);
+            }
+        }
+
+        return numRead;
+    }
+
+    void prepareToWrite (int numToWrite, int& startIndex1, int& blockSize1, int& startIndex2, int& blockSize2) noexcept
+    {
+        fifo.prepareToWrite (numToWrite, startIndex1, blockSize1, startIndex2, blockSize2);
+
+        if (blockSize1 + blockSize2 < numToWrite)
+            numOverruns.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    void finishedWrite (int numWritten) noexcept
+    {
+        fifo.finishedWrite (numWritten);
+    }
+
+    void prepareToRead (int numWanted, int& startIndex1, int& blockSize1, int& startIndex2, int& blockSize2) noexcept
+    {
+        fifo.prepareToRead (numWanted, startIndex1, blockSize1, startIndex2, blockSize2);
+
+        if (blockSize1 + blockSize2 < numWanted)
+            numUnderruns.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    void finishedRead (int numRead) noexcept
+    {
+        fifo.finishedRead (numRead);
+    }
+
+    /** Discards all the content, not thread safe with respect to concurrent reads and writes. */
+    void reset() noexcept
+    {
+        fifo.reset();
+        resetCounters();
+    }
+
+    juce::int64 getNumOverruns() const noexcept { return numOverruns.load (std::memory_order_relaxed); }
+    juce::int64 getNumUnderruns() const noexcept { return numUnderruns.load (std::memory_order_relaxed); }
+
+    void resetCounters() noexcept
+    {
+        numOverruns.store (0, std::memory_order_relaxed);
+        numUnderruns.store (0, std::memory_order_relaxed);
+    }
+
+private:
+    void copyToStorage (const float* const* channels, int numSourceChannels, int sourceOffset, int startIndex, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            if (channel < numSourceChannels && channels[channel] != nullptr)
+                juce::FloatVectorOperations::copy (getChannelData (channel, startIndex), channels[channel] + sourceOffset, numSamples);
+            else
+                juce::FloatVectorOperations::clear (getChannelData (channel, startIndex), numSamples);
+        }
+    }
+
+    void copyFromStorage (float* const* channels, int numDestChannels, int destOffset, int startIndex, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        for (int channel = 0; channel < numDestChannels; ++channel)
+        {
+            if (channels[channel] == nullptr)
+                continue;
+
+            if (channel < numChannels)
+                juce::FloatVectorOperations::copy (channels[channel] + destOffset, getChannelData (channel, startIndex), numSamples);
+            else
+                juce::FloatVectorOperations::clear (channels[channel] + destOffset, numSamples);
+        }
+    }
+
+    int numChannels = 0;
+    juce::AbstractFifo fifo;
+    std::vector<float> storage;
+
+    std::atomic<juce::int64> numOverruns { 0 };
+    std::atomic<juce::int64> numUnderruns { 0 };
+};
+
+// =================================================================================================
+
+/**
+ * @brief Computes peak, RMS, true peak and clip counts for a bank of channels on the audio thread.
+ *
+ * Levels accumulate until the reader takes a snapshot, so no peak between two GUI redraws is lost. Snapshots are
+ * exchanged through a lock-free triple buffer, with one row per channel laid out as (peak, rms, truePeak, clipCount).
+ * True peak is estimated by 4x Catmull-Rom interpolation between consecutive samples.
+ */
+class LevelMeterBank
+{
+public:
+    enum Field
+    {
+        peakField,
+        rmsField,
+        truePeakField,
+        clipCountField,
+        numFields
+    };
+
+    explicit LevelMeterBank (int numChannelsToMeter, float clipThresholdToUse = 1.0f)
+        : numChannels (juce::jmax (0, numChannelsToMeter))
+        , clipThreshold (clipThresholdToUse)
+        , channels (static_cast<size_t> (numChannels))
+    {
+        for (auto& snapshot : snapshots)
+            snapshot.assign (static_cast<size_t> (numChannels * numFields), 0.0);
+    }
+
+    int getNumChannels() const noexcept { return numChannels; }
+
+    void setClipThreshold (float newThreshold) noexcept { clipThreshold.store (newThreshold, std::memory_order_relaxed); }
+    float getClipThreshold() const noexcept { return clipThreshold.load (std::memory_order_relaxed); }
+
+    /** Meters a block of channel data and publishes a new snapshot, to be called from a single writer thread. */
+    void process (const float* const* channelData, int numChannelsToProcess, int startSample, int numSamples) noexcept
+    {
+        beginBlock();
+
+        const auto threshold = getClipThreshold();
+        for (int channel = 0; channel < juce::jmin (numChannels, numChannelsToProcess); ++channel)
+        {
+            if (channelData[channel] != nullptr)
+                processChannel (channels[static_cast<size_t> (channel)], channelData[channel] + startSample, numSamples, threshold);
+        }
+
+        publish();
+    }
+
+    void process (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+    {
+        process (buffer.getArrayOfReadPointers(), buffer.getNumChannels(), startSample, numSamples);
+    }
+
+    /** Copies the latest snapshot into numChannels * numFields values, returns true if it's newer than the previous one. */
+    bool getSnapshot (double* dest) noexcept
+    {
+        auto isFresh = false;
+
+        if ((readyIndex.load (std::memory_order_acquire) & freshBit) != 0)
+        {
+            readIndex = readyIndex.exchange (readIndex, std::memory_order_acq_rel) & indexMask;
+            consumed.store (true, std::memory_order_release);
+            isFresh = true;
+        }
+
+        std::copy (snapshots[static_cast<size_t> (readIndex)].begin(), snapshots[static_cast<size_t> (readIndex)].end(), dest);
+        return isFresh;
+    }
+
+    /** Requests the writer to clear the accumulated levels and clip counts before the next block. */
+    void reset() noexcept
+    {
+        resetRequested.store (true, std::memory_order_release);
+    }
+
+private:
+    struct ChannelState
+    {
+        float history[3] = { 0.0f, 0.0f, 0.0f };
+        float peak = 0.0f;
+        float truePeak = 0.0f;
+        double sumOfSquares = 0.0;
+        juce::int64 numSamples = 0;
+        juce::int64 numClips = 0;
+    };
+
+    static constexpr int freshBit = 4;
+    static constexpr int indexMask = 3;
+    static constexpr int numInterpolatedPoints = 3;
+
+    struct InterpolationWeights
+    {
+        float weights[numInterpolatedPoints][4];
+
+        constexpr InterpolationWeights()
+            : weights()
+        {
+            for (int point = 0; point < numInterpolatedPoints; ++point)
+            {
+                const auto t = static_cast<float> (point + 1) / static_cast<float> (numInterpolatedPoints + 1);
+                const auto t2 = t * t;
+                const auto t3 = t2 * t;
+
+                weights[point][0] = 0.5f * (-t + 2.0f * t2 - t3);
+                weights[point][1] = 0.5f * (2.0f - 5.0f * t2 + 3.0f * t3);
+                weights[point][2] = 0.5f * (t + 4.0f * t2 - 3.0f * t3);
+                weights[point][3] = 0.5f * (-t2 + t3);
+            }
+        }
+    };
+
+    void beginBlock() noexcept
+    {
+        const auto shouldReset = resetRequested.exchange (false, std::memory_order_acq_rel);
+        const auto wasConsumed = consumed.exchange (false, std::memory_order_acq_rel);
+
+        if (! shouldReset && ! wasConsumed)
+            return;
+
+        for (auto& state : channels)
+        {
+            state.peak = 0.0f;
+            state.truePeak = 0.0f;
+            state.sumOfSquares = 0.0;
+            state.numSamples = 0;
+
+            if (shouldReset)
+                state.numClips = 0;
+        }
+    }
+
+    static void processChannel (ChannelState& state, const float* data, int numSamples, float threshold) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        static constexpr InterpolationWeights interpolation;
+
+        const auto range = juce::FloatVectorOperations::findMinAndMax (data, numSamples);
+        state.peak = juce::jmax (state.peak, std::abs (range.getStart()), std::abs (range.getEnd()));
+
+        double sumOfSquares = 0.0;
+        juce::int64 numClips = 0;
+        auto truePeak = state.truePeak;
+        auto [xm1, x0, x1] = state.history;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto x2 = data[i];
+
+            sumOfSquares += static_cast<double> (x2) * x2;
+            numClips += std::abs (x2) >= threshold ? 1 : 0;
+
+            for (const auto& w : interpolation.weights)
+                truePeak = juce::jmax (truePeak, std::abs (w[0] * xm1 + w[1] * x0 + w[2] * x1 + w[3] * x2));
+
+            xm1 = x0;
+            x0 = x1;
+            x1 = x2;
+        }
+
+        state.history[0] = xm1;
+        state.history[1] = x0;
+        state.history[2] = x1;
+
+        state.sumOfSquares += sumOfSquares;
+        state.numSamples += numSamples;
+        state.numClips += numClips;
+        state.truePeak = juce::jmax (truePeak, state.peak);
+    }
+
+    void publish() noexcept
+    {
+        auto& snapshot = snapshots[static_cast<size_t> (writeIndex)];
+
+        for (size_t channel = 0; channel < channels.size(); ++channel)
+        {
+            const auto& state = channels[channel];
+            auto row = snapshot.data() + channel * numFields;
+
+            row[peakField] = state.peak;
+            row[rmsField] = state.numSamples > 0 ? std::sqrt (state.sumOfSquares / static_cast<double> (state.numSamples)) : 0.0;
+            row[truePeakField] = state.truePeak;
+            row[clipCountField] = static_cast<double> (state.numClips);
+        }
+
+        writeIndex = readyIndex.exchange (writeIndex | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    const int numChannels;
+    std::atomic<float> clipThreshold;
+    std::vector<ChannelState> channels;
+
+    std::array<std::vector<double>, 3> snapshots;
+    std::atomic<int> readyIndex { 1 };
+    int writeIndex = 0;
+    int readIndex = 2;
+
+    std::atomic<bool> consumed { false };
+    std::atomic<bool> resetRequested { false };
+};
+
+// =================================================================================================
+
+/**
+ * @brief Opt-in monitor timing python audio callbacks against the duration of the block they render.
+ *
+ * Every monitored invocation is recorded in a histogram of its duration relative to the block duration. After a
+ * configurable number of consecutive missed deadlines the monitor enters fallback mode, where python is skipped and
+ * the fallback policy decides what is rendered instead, optionally retrying python every few blocks.
+ */
+class PyCallbackDeadlineMonitor
+{
+public:
+    enum class FallbackPolicy
+    {
+        none,
+        silence,
+        repeatLastBlock,
+        bypass
+    };
+
+    static constexpr int numHistogramBins = 8;
+    static constexpr int defaultMaxNumChannels = 8;
+    static constexpr double histogramBinEdges[numHistogramBins - 1] = { 0.25, 0.5, 0.75, 1.0, 1.5, 2.0, 4.0 };
+
+    PyCallbackDeadlineMonitor() = default;
+
+    void setEnabled (bool shouldBeEnabled) noexcept { enabled.store (shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept { return enabled.load (std::memory_order_relaxed); }
+
+    /** Sets the fraction of the block duration a callback is allowed to take before it's considered a miss. */
+    void setDeadlineRatio (double newRatio) noexcept { deadlineRatio.store (juce::jmax (0.0, newRatio), std::memory_order_relaxed); }
+    double getDeadlineRatio() const noexcept { return deadlineRatio.load (std::memory_order_relaxed); }
+
+    void setFallbackPolicy (FallbackPolicy newPolicy, int newMaxConsecutiveMisses) noexcept
+    {
+        maxConsecutiveMisses.store (juce::jmax (1, newMaxConsecutiveMisses), std::memory_order_relaxed);
+        fallbackPolicy.store (newPolicy, std::memory_order_relaxed);
+    }
+
+    FallbackPolicy getFallbackPolicy() const noexcept { return fallbackPolicy.load (std::memory_order_relaxed); }
+    int getMaxConsecutiveMisses() const noexcept { return maxConsecutiveMisses.load (std::memory_order_relaxed); }
+
+    /** Sets how many blocks to wait in fallback mode before trying python again, zero never retries. */
+    void setRetryInterval (int numBlocks) noexcept { retryInterval.store (juce::jmax (0, numBlocks), std::memory_order_relaxed); }
+    int getRetryInterval() const noexcept { return retryInterval.load (std::memory_order_relaxed); }
+
+    /** Sets how many channels sources without a known layout keep for the repeat policy, applied on the next prepare. */
+    void setMaxNumChannels (int newMaxNumChannels) noexcept { maxNumChannels.store (juce::jmax (1, newMaxNumChannels), std::memory_order_relaxed); }
+    int getMaxNumChannels() const noexcept { return maxNumChannels.load (std::memory_order_relaxed); }
+
+    bool isInFallback() const noexcept { return inFallback.load (std::memory_order_relaxed); }
+
+    void resetFallback() noexcept
+    {
+        inFallback.store (false, std::memory_order_relaxed);
+        consecutiveMisses.store (0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Prepares for rendering, must not be called while rendering.
+     *
+     * The storage for the last rendered block is allocated here for the specified number of channels, so the monitor
+     * can be enabled at any time and the audio thread never allocates.
+     */
+    void prepare (double newSampleRate, int maxBlockSize, int numChannels)
+    {
+        sampleRate.store (newSampleRate, std::memory_order_relaxed);
+
+        lastBlock.setSize (juce::jmax (0, numChannels), juce::jmax (0, maxBlockSize));
+
+        lastBlockSize = 0;
+        blocksSinceRetry = 0;
+
+        resetFallback();
+    }
+
+    /** Returns true if python should render the next block, false if the fallback must be applied instead. */
+    bool beginCallback() noexcept
+    {
+        if (! isInFallback())
+            return true;
+
+        const auto interval = getRetryInterval();
+        if (interval > 0 && ++blocksSinceRetry >= interval)
+        {
+            blocksSinceRetry = 0;
+            return true;
+        }
+
+        numFallbackBlocks.fetch_add (1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /** Registers the time spent by python rendering a block, returns true if the deadline was met. */
+    bool endCallback (double elapsedMilliseconds, int numSamples) noexcept
+    {
+        numCallbacks.fetch_add (1, std::memory_order_relaxed);
+
+        auto previousMax = maxCallbackMilliseconds.load (std::memory_order_relaxed);
+        while (elapsedMilliseconds > previousMax
+               && ! maxCallbackMilliseconds.compare_exchange_weak (previousMax, elapsedMilliseconds, std::memory_order_relaxed))
+        {
+        }
+
+        const auto currentSampleRate = sampleRate.load (std::memory_order_relaxed);
+        if (currentSampleRate <= 0.0 || numSamples <= 0)
+            return true;
+
+        const auto blockMilliseconds = 1000.0 * numSamples / currentSampleRate;
+        const auto load = elapsedMilliseconds / blockMilliseconds;
+
+        int bin = 0;
+        while (bin < numHistogramBins - 1 && load >= histogramBinEdges[bin])
+            ++bin;
+
+        histogram[static_cast<size_t> (bin)].fetch_add (1, std::memory_order_relaxed);
+
+        if (load <= getDeadlineRatio())
+        {
+            consecutiveMisses.store (0, std::memory_order_relaxed);
+            inFallback.store (false, std::memory_order_relaxed);
+            return true;
+        }
+
+        numMisses.fetch_add (1, std::memory_order_relaxed);
+
+        const auto misses = consecutiveMisses.fetch_add (1, std::memory_order_relaxed) + 1;
+        if (getFallbackPolicy() != FallbackPolicy::none && misses >= getMaxConsecutiveMisses())
+            inFallback.store (true, std::memory_order_relaxed);
+
+        return false;
+    }
+
+    /**
+     * Keeps a copy of the rendered block, to be repeated by the fallback.
+     *
+     * Channels and samples beyond the prepared storage are dropped and counted as a truncated block.
+     */
+    void storeBlock (const float* const* channels, int numChannels, int startSample, int numSamples) noexcept
+    {
+        if (getFallbackPolicy() != FallbackPolicy::repeatLastBlock)
+            return;
+
+        const auto numChannelsToStore = juce::jmin (numChannels, lastBlock.getNumChannels());
+        const auto numSamplesToStore = juce::jmin (numSamples, lastBlock.getNumSamples());
+
+        if (numChannelsToStore < numChannels || numSamplesToStore < numSamples)
+            numTruncatedBlocks.fetch_add (1, std::memory_order_relaxed);
+
+        for (int channel = 0; channel < numChannelsToStore; ++channel)
+        {
+            if (channels[channel] != nullptr)
+                lastBlock.copyFrom (channel, 0, channels[channel] + startSample, numSamplesToStore);
+            else
+                lastBlock.clear (channel, 0, numSamplesToStore);
+        }
+
+        lastBlockSize = numChannelsToStore > 0 ? numSamplesToStore : 0;
+    }
+
+    /** Renders silence or the last stored block, depending on the policy. */
+    void applyFallback (float* const* channels, int numChannels, int startSample, int numSamples) noexcept
+    {
+        const auto canRepeat = getFallbackPolicy() == FallbackPolicy::repeatLastBlock && lastBlockSize > 0;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            if (channels[channel] == nullptr)
+                continue;
+
+            auto dest = channels[channel] + startSample;
+
+            if (! canRepeat || channel >= lastBlock.getNumChannels())
+            {
+                juce::FloatVectorOperations::clear (dest, numSamples);
+                continue;
+            }
+
+            // Loop the stored block when the requested block is longer
+            for (int offset = 0; offset < numSamples; offset += lastBlockSize)
+                juce::FloatVectorOperations::copy (dest + offset, lastBlock.getReadPointer (channel), juce::jmin (lastBlockSize, numSamples - offset));
+        }
+    }
+
+    juce::int64 getNumCallbacks() const noexcept { return numCallbacks.load (std::memory_order_relaxed); }
+    juce::int64 getNumMisses() const noexcept { return numMisses.load (std::memory_order_relaxed); }
+    int getNumConsecutiveMisses() const noexcept { return consecutiveMisses.load (std::memory_order_relaxed); }
+    juce::int64 getNumFallbackBlocks() const noexcept { return numFallbackBlocks.load (std::memory_order_relaxed); }
+    juce::int64 getNumTruncatedBlocks() const noexcept { return numTruncatedBlocks.load (std::memory_order_relaxed); }
+    double getMaxCallbackMilliseconds() const noexcept { return maxCallbackMilliseconds.load (std::memory_order_relaxed); }
+
+    juce::int64 getHistogramBin (int bin) const noexcept
+    {
+        return juce::isPositiveAndBelow (bin, numHistogramBins) ? histogram[static_cast<size_t> (bin)].load (std::memory_order_relaxed) : 0;
+    }
+
+    void resetStatistics() noexcept
+    {
+        numCallbacks.store (0, std::memory_order_relaxed);
+        numMisses.store (0, std::memory_order_relaxed);
+        numFallbackBlocks.store (0, std::memory_order_relaxed);
+        numTruncatedBlocks.store (0, std::memory_order_relaxed);
+        maxCallbackMilliseconds.store (0.0, std::memory_order_relaxed);
+
+        for (auto& bin : histogram)
+            bin.store (0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> enabled { false };
+    std::atomic<double> deadlineRatio { 1.0 };
+    std::atomic<FallbackPolicy> fallbackPolicy { FallbackPolicy::none };
+    std::atomic<int> maxConsecutiveMisses { 1 };
+    std::atomic<int> retryInterval { 0 };
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<int> maxNumChannels { defaultMaxNumChannels };
+
+    std::atomic<bool> inFallback { false };
+    std::atomic<int> consecutiveMisses { 0 };
+    int blocksSinceRetry = 0;
+
+    juce::AudioBuffer<float> lastBlock;
+    int lastBlockSize = 0;
+
+    std::atomic<juce::int64> numCallbacks { 0 };
+    std::atomic<juce::int64> numMisses { 0 };
+    std::atomic<juce::int64> numFallbackBlocks { 0 };
+    std::atomic<juce::int64> numTruncatedBlocks { 0 };
+    std::atomic<double> maxCallbackMilliseconds { 0.0 };
+    std::array<std::atomic<juce::int64>, numHistogramBins> histogram {};
+};
+
+// =================================================================================================
+
+/**
+ * @brief Non templated state shared by all the python audio sources, to be queried from the bindings.
+ */
+struct PyAudioSourceState
+{
+    virtual ~PyAudioSourceState() = default;
+
+    PyCallbackDeadlineMonitor& getDeadlineMonitor() noexcept
+    {
+        return deadlineMonitor;
+    }
+
+protected:
+    PyCallbackDeadlineMonitor deadlineMonitor;
+};
+
+// =================================================================================================
+
 struct PyAudioPlayHead : juce::AudioPlayHead
 {
     using juce::AudioPlayHead::AudioPlayHead;
@@ -102,13 +1097,127 @@ struct PyAudioPlayHead : juce::AudioPlayHead
 
 // =================================================================================================
 
+/**
+ * @brief A native AudioPlayHead returning the last position published by its owner, without calling into python.
+ *
+ * Positions are exchanged through a sequence lock, so a single writer thread can publish while any number of readers,
+ * including the audio thread, copy the latest snapshot without the GIL. While playing, the returned position can be
+ * extrapolated from the wall clock time elapsed since the last update.
+ */
+class CachedAudioPlayHead : public juce::AudioPlayHead
+{
+public:
+    CachedAudioPlayHead() = default;
+
+    /** Publishes a new position, or clears it when passed an empty optional. */
+    void setPosition (const juce::Optional<PositionInfo>& newPosition) noexcept
+    {
+        const auto ticks = juce::Time::getHighResolutionTicks();
+
+        sequence.fetch_add (1, std::memory_order_acq_rel);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        snapshot.position = newPosition;
+        snapshot.updateTicks = ticks;
+
+        sequence.fetch_add (1, std::memory_order_release);
+        numUpdates.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    juce::Optional<PositionInfo> getPosition() const override
+    {
+        Snapshot copy;
+
+        for (;;)
+        {
+            const auto before = sequence.load (std::memory_order_acquire);
+
+            if ((before & 1) == 0)
+            {
+                copy = snapshot;
+                std::atomic_thread_fence (std::memory_order_acquire);
+
+                if (sequence.load (std::memory_order_relaxed) == before)
+                    break;
+            }
+        }
+
+        if (! copy.position.hasValue() || ! extrapolating.load (std::memory_order_relaxed))
+            return copy.position;
+
+        return extrapolate (*copy.position, copy.updateTicks);
+    }
+
+    /** Enables the extrapolation of the position while playing, sample positions are advanced using the sample rate. */
+    void setExtrapolation (bool shouldExtrapolate, double newSampleRate) noexcept
+    {
+        sampleRate.store (newSampleRate, std::memory_order_relaxed);
+        extrapolating.store (shouldExtrapolate, std::memory_order_relaxed);
+    }
+
+    bool isExtrapolating() const noexcept { return extrapolating.load (std::memory_order_relaxed); }
+    double getSampleRate() const noexcept { return sampleRate.load (std::memory_order_relaxed); }
+    juce::int64 getNumUpdates() const noexcept { return numUpdates.load (std::memory_order_relaxed); }
+
+private:
+    struct Snapshot
+    {
+        juce::Optional<PositionInfo> position;
+        juce::int64 updateTicks = 0;
+    };
+
+    PositionInfo extrapolate (PositionInfo position, juce::int64 updateTicks) const noexcept
+    {
+        if (! position.getIsPlaying())
+            return position;
+
+        const auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - updateTicks);
+
+        if (const auto timeInSeconds = position.getTimeInSeconds())
+            position.setTimeInSeconds (*timeInSeconds + elapsedSeconds);
+
+        if (const auto timeInSamples = position.getTimeInSamples(); timeInSamples && getSampleRate() > 0.0)
+            position.setTimeInSamples (*timeInSamples + static_cast<juce::int64> (elapsedSeconds * getSampleRate()));
+
+        if (const auto hostTimeNs = position.getHostTimeNs())
+            position.setHostTimeNs (*hostTimeNs + static_cast<juce::uint64> (elapsedSeconds * 1.0e9));
+
+        const auto ppqPosition = position.getPpqPosition();
+        const auto bpm = position.getBpm();
+
+        if (ppqPosition && bpm)
+        {
+            auto newPpqPosition = *ppqPosition + elapsedSeconds * *bpm / 60.0;
+
+            const auto loopPoints = position.getLoopPoints();
+            if (position.getIsLooping() && loopPoints && loopPoints->ppqEnd > loopPoints->ppqStart && newPpqPosition >= loopPoints->ppqEnd)
+                newPpqPosition = loopPoints->ppqStart + std::fmod (newPpqPosition - loopPoints->ppqStart, loopPoints->ppqEnd - loopPoints->ppqStart);
+
+            position.setPpqPosition (newPpqPosition);
+        }
+
+        return position;
+    }
+
+    Snapshot snapshot;
+    std::atomic<juce::uint32> sequence { 0 };
+    std::atomic<juce::int64> numUpdates { 0 };
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<bool> extrapolating { false };
+};
+
+// =================================================================================================
+
 template <class Base = juce::AudioSource>
-struct PyAudioSource : Base
+struct PyAudioSource : Base, PyAudioSourceState
 {
     using Base::Base;
 
     void prepareToPlay (int newSamplesPerBlockExpected, double newSampleRate) override
     {
+        // The number of channels is only known when the first block is rendered, so the configured maximum is kept
+        deadlineMonitor.prepare (newSampleRate, newSamplesPerBlockExpected, deadlineMonitor.getMaxNumChannels());
+
         PYBIND11_OVERRIDE_PURE (void, Base, prepareToPlay, newSamplesPerBlockExpected, newSampleRate);
     }
 
@@ -119,7 +1228,35 @@ struct PyAudioSource : Base
 
     void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override
     {
-        PYBIND11_OVERRIDE_PURE (void, Base, getNextAudioBlock, bufferToFill);
+        if (! deadlineMonitor.isEnabled())
+            return invokeGetNextAudioBlock (bufferToFill);
+
+        auto buffer = bufferToFill.buffer;
+
+        if (! deadlineMonitor.beginCallback())
+        {
+            if (deadlineMonitor.getFallbackPolicy() == PyCallbackDeadlineMonitor::FallbackPolicy::bypass)
+            {
+                if constexpr (! std::is_abstract_v<Base>)
+                    return Base::getNextAudioBlock (bufferToFill);
+            }
+
+            deadlineMonitor.applyFallback (buffer->getArrayOfWritePointers(), buffer->getNumChannels(), bufferToFill.startSample, bufferToFill.numSamples);
+            return;
+        }
+
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        invokeGetNextAudioBlock (bufferToFill);
+
+        deadlineMonitor.endCallback (juce::Time::getMillisecondCounterHiRes() - startTime, bufferToFill.numSamples);
+        deadlineMonitor.storeBlock (buffer->getArrayOfReadPointers(), buffer->getNumChannels(), bufferToFill.startSample, bufferToFill.numSamples);
+    }
+
+private:
+    void invokeGetNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
+    {
+        PYBIND11_OVERRIDE_PURE_NAME (void, Base, "getNextAudioBlock", getNextAudioBlock, bufferToFill);
     }
 };
 
@@ -94,6 +94,73 @@ void registerJuceAudioDevicesBindings (py::module_& m)
         .def ("audioDeviceAboutToStart", &AudioIODeviceCallback::audioDeviceAboutToStart, "device"_a)
         .def ("audioDeviceStopped", &AudioIODeviceCallback::audioDeviceStopped)
         .def ("audioDeviceError", &AudioIODeviceCallback::audioDeviceError, "errorMessage"_a)
+        .def ("renderDeviceBlock", [](AudioIODeviceCallback& self, py::buffer inputChannels, py::buffer outputChannels, const AudioIODeviceCallbackContext& context)
+        {
+            const auto inputInfo = inputChannels.request();
+            const auto outputInfo = outputChannels.request (true);
+
+            int numInputSamples = 0, numOutputSamples = 0;
+            const auto inputs = getBufferChannelPointers<const float> (inputInfo, numInputSamples);
+            const auto outputs = getBufferChannelPointers<float> (outputInfo, numOutputSamples);
+
+            if (! inputs.empty() && numInputSamples != numOutputSamples)
+                py::pybind11_fail ("Input and output buffers must contain the same number of samples");
+
+            py::gil_scoped_release release;
+            self.audioDeviceIOCallbackWithContext (inputs.data(), static_cast<int> (inputs.size()),
+                                                   outputs.data(), static_cast<int> (outputs.size()),
+                                                   numOutputSamples, context);
+        }, "inputChannels"_a, "outputChannels"_a, "context"_a = AudioIODeviceCallbackContext{})
+        .def ("getNumPythonAllocationsInLastCallback", [](const AudioIODeviceCallback& self)
+        {
+            if (auto state = dynamic_cast<const PyAudioIODeviceCallbackState*> (&self))
+                return state->getNumPythonAllocationsInLastCallback();
+
+            return 0;
+        })
+        .def ("getTotalNumPythonAllocations", [](const AudioIODeviceCallback& self)
+        {
+            if (auto state = dynamic_cast<const PyAudioIODeviceCallbackState*> (&self))
+                return state->getTotalNumPythonAllocations();
+
+            return juce::int64 (0);
+        })
+        .def ("setBlockCoalescing", [](AudioIODeviceCallback& self, int numBlocks)
+        {
+            auto state = dynamic_cast<PyAudioIODeviceCallbackState*> (&self);
+            if (state == nullptr)
+                py::pybind11_fail ("Block coalescing is only available on python audio device callbacks");
+
+            state->setBlockCoalescing (numBlocks);
+        }, "numBlocks"_a)
+        .def ("getBlockCoalescing", [](const AudioIODeviceCallback& self)
+        {
+            if (auto state = dynamic_cast<const PyAudioIODeviceCallbackState*> (&self))
+                return state->getBlockCoalescing();
+
+            return 1;
+        })
+        .def ("getCoalescingLatencySamples", [](const AudioIODeviceCallback& self)
+        {
+            if (auto state = dynamic_cast<const PyAudioIODeviceCallbackState*> (&self))
+                return state->getCoalescingLatencySamples();
+
+            return 0;
+        })
+        .def ("getNumLateCoalescedBlocks", [](const AudioIODeviceCallback& self)
+        {
+            if (auto state = dynamic_cast<const PyAudioIODeviceCallbackState*> (&self))
+                return state->getNumLateCoalescedBlocks();
+
+            return juce::int64 (0);
+        })
+        .def ("getDeadlineMonitor", [](AudioIODeviceCallback& self) -> PyCallbackDeadlineMonitor*
+        {
+            if (auto state = dynamic_cast<PyAudioIODeviceCallbackState*> (&self))
+                return &state->getDeadlineMonitor();
+
+            return nullptr;
+        }, py::return_value_policy::reference_internal)
     ;
 
     // ============================================================================================ juce::AudioIODeviceCallback
@@ -92,11 +92,155 @@ struct PyAudioIODeviceTypeListener : juce::AudioIODeviceType::Listener
 
 // =================================================================================================
 
+/**
+ * @brief A list of python channel views handed to audio callbacks.
+ *
+ * The list and its views are allocated once, then retargeted in place to the channel data of every new block so
+ * the audio thread doesn't create python objects unless the number of channels changes. Must be used with the GIL held.
+ */
+template <class T>
+class PyChannelViewList
+{
+public:
+    PyChannelViewList() = default;
+
+    /** Allocates the python list and views for the specified number of channels, returns the number of objects created. */
+    int allocate (size_t numChannels)
+    {
+        views.clear();
+        views.reserve (numChannels);
+
+        list = pybind11::list (numChannels);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto object = pybind11::cast (PyArrayView<T>());
+            auto view = object.template cast<PyArrayView<T>*>();
+
+            PyList_SET_ITEM (list.ptr(), static_cast<Py_ssize_t> (channel), object.inc_ref().ptr());
+            views.push_back ({ std::move (object), view });
+        }
+
+        return static_cast<int> (numChannels) + 1;
+    }
+
+    /** Points the views to new channel data, returns the number of python objects that had to be created. */
+    int update (T* const* channelData, size_t numChannels, size_t numSamples)
+    {
+        int numAllocations = 0;
+
+        if (views.size() != numChannels || static_cast<size_t> (PyList_GET_SIZE (list.ptr())) != numChannels)
+            numAllocations += allocate (numChannels);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto& item = views[channel];
+            item.view->setData (channelData[channel], numSamples);
+
+            // Restore the list content in case the callback replaced any of the views
+            if (PyList_GET_ITEM (list.ptr(), static_cast<Py_ssize_t> (channel)) != item.object.ptr())
+                list[channel] = item.object;
+        }
+
+        return numAllocations;
+    }
+
+    const pybind11::list& getList() const noexcept
+    {
+        return list;
+    }
+
+private:
+    struct ChannelView
+    {
+        pybind11::object object;
+        PyArrayView<T>* view = nullptr;
+    };
+
+    std::vector<ChannelView> views;
+    pybind11::list list;
+};
+
+// =================================================================================================
+
+/**
+ * @brief Non templated state shared by all the python audio device callbacks, to be queried from the bindings.
+ */
+struct PyAudioIODeviceCallbackState
+{
+    virtual ~PyAudioIODeviceCallbackState() = default;
+
+    /** Returns the number of python objects allocated when dispatching the last block to python. */
+    int getNumPythonAllocationsInLastCallback() const noexcept
+    {
+        return numAllocationsInLastCallback.load (std::memory_order_relaxed);
+    }
+
+    /** Returns the number of python objects allocated when dispatching blocks to python since creation. */
+    juce::int64 getTotalNumPythonAllocations() const noexcept
+    {
+        return totalNumAllocations.load (std::memory_order_relaxed);
+    }
+
+    PyCallbackDeadlineMonitor& getDeadlineMonitor() noexcept
+    {
+        return deadlineMonitor;
+    }
+
+    /** Sets how many hardware blocks are aggregated before calling python, applied the next time the device starts. */
+    void setBlockCoalescing (int numBlocks) noexcept
+    {
+        coalescingFactor.store (juce::jmax (1, numBlocks), std::memory_order_relaxed);
+    }
+
+    int getBlockCoalescing() const noexcept
+    {
+        return coalescingFactor.load (std::memory_order_relaxed);
+    }
+
+    /** Returns the latency in samples added by block coalescing on the running device. */
+    int getCoalescingLatencySamples() const noexcept
+    {
+        return coalescingLatency.load (std::memory_order_relaxed);
+    }
+
+    /** Returns the number of aggregated blocks that python didn't finish rendering before they had to be played. */
+    juce::int64 getNumLateCoalescedBlocks() const noexcept
+    {
+        return numLateCoalescedBlocks.load (std::memory_order_relaxed);
+    }
+
+protected:
+    void registerCallbackAllocations (int numAllocations) noexcept
+    {
+        numAllocationsInLastCallback.store (numAllocations, std::memory_order_relaxed);
+
+        if (numAllocations > 0)
+            totalNumAllocations.fetch_add (numAllocations, std::memory_order_relaxed);
+    }
+
+    PyCallbackDeadlineMonitor deadlineMonitor;
+    std::atomic<int> coalescingFactor { 1 };
+    std::atomic<int> coalescingLatency { 0 };
+    std::atomic<juce::int64> numLateCoalescedBlocks { 0 };
+
+private:
+    std::atomic<int> numAllocationsInLastCallback { 0 };
+    std::atomic<juce::int64> totalNumAllocations { 0 };
+};
+
+// =================================================================================================
+
 template <class Base = juce::AudioIODeviceCallback>
-struct PyAudioIODeviceCallback : Base
+struct PyAudioIODeviceCallback : Base, PyAudioIODeviceCallbackState
 {
     using Base::Base;
 
+    ~PyAudioIODeviceCallback() override
+    {
+        stopCoalescedRendering();
+    }
+
     void audioDeviceIOCallbackWithContext (const float* const* inputChannelData,
                                            int numInputChannels,
                                            float* const* outputChannelData,
@@ -104,37 +248,116 @@ struct PyAudioIODeviceCallback : Base
                                            int numSamples,
                                            const juce::AudioIODeviceCallbackContext& context) override
     {
-        pybind11::gil_scoped_acquire gil;
+        if (coalescedBlockSize <= 0)
+            return processBlock (inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples, context);
 
-        if (! override_)
+        // Inputs are accumulated in one slot while python renders the previously accumulated slot on the render thread,
+        // and outputs are served from the slot rendered before that. Python has a whole aggregated block of hardware
+        // periods to render, at the cost of a fixed latency of two aggregated blocks.
+        for (int offset = 0; offset < numSamples;)
         {
-            override_ = pybind11::get_override (static_cast<Base*> (this), "audioDeviceIOCallbackWithContext");
-            if (! override_)
-                return;
+            auto& capture = coalescedSlots[static_cast<size_t> (captureSlot)];
+            auto& playback = coalescedSlots[static_cast<size_t> (playbackSlot)];
+
+            const auto numThisTime = juce::jmin (numSamples - offset, coalescedBlockSize - coalescedPosition);
+
+            if (coalescedPosition == 0)
+            {
+                capture.hasHostTime = context.hostTimeNs != nullptr;
+                capture.hostTimeNs = capture.hasHostTime ? *context.hostTimeNs : 0;
+            }
+
+            for (int channel = 0; channel < capture.inputs.getNumChannels(); ++channel)
+            {
+                if (channel < numInputChannels && inputChannelData[channel] != nullptr)
+                    capture.inputs.copyFrom (channel, coalescedPosition, inputChannelData[channel] + offset, numThisTime);
+                else
+                    capture.inputs.clear (channel, coalescedPosition, numThisTime);
+            }
+
+            for (int channel = 0; channel < numOutputChannels; ++channel)
+            {
+                if (outputChannelData[channel] == nullptr)
+                    continue;
+
+                if (channel < playback.outputs.getNumChannels())
+                    juce::FloatVectorOperations::copy (outputChannelData[channel] + offset, playback.outputs.getReadPointer (channel, coalescedPosition), numThisTime);
+                else
+                    juce::FloatVectorOperations::clear (outputChannelData[channel] + offset, numThisTime);
+            }
+
+            coalescedPosition += numThisTime;
+            offset += numThisTime;
+
+            if (coalescedPosition == coalescedBlockSize)
+            {
+                coalescedPosition = 0;
+                dispatchCoalescedBlock();
+            }
         }
-
-        const auto numInputs = static_cast<size_t> (numInputChannels);
-
-        pybind11::list inputs (numInputs);
-        for (size_t i = 0; i < numInputs; ++i)
-            inputs[i] = PyArrayView<const float> (inputChannelData[i], static_cast<size_t> (numSamples));
-
-        const auto numOutputs = static_cast<size_t> (numOutputChannels);
-
-        pybind11::list outputs (numOutputs);
-        for (size_t i = 0; i < numOutputs; ++i)
-            outputs[i] = PyArrayView<float> (outputChannelData[i], static_cast<size_t> (numSamples));
-
-        override_ (inputs, numInputChannels, outputs, numOutputChannels, numSamples, context);
     }
 
     void audioDeviceAboutToStart (juce::AudioIODevice* device) override
     {
+        stopCoalescedRendering();
+
+        {
+            pybind11::gil_scoped_acquire gil;
+
+            hasLookedUpOverride = false;
+            prepareCallbackObjects();
+
+            coalescedBlockSize = 0;
+
+            if (device != nullptr)
+            {
+                const auto numInputChannels = device->getActiveInputChannels().countNumberOfSetBits();
+                const auto numOutputChannels = device->getActiveOutputChannels().countNumberOfSetBits();
+                const auto hardwareBlockSize = device->getCurrentBufferSizeSamples();
+                const auto factor = getBlockCoalescing();
+
+                inputViews.allocate (static_cast<size_t> (numInputChannels));
+                outputViews.allocate (static_cast<size_t> (numOutputChannels));
+
+                if (factor > 1)
+                {
+                    coalescedBlockSize = factor * hardwareBlockSize;
+                    coalescedPosition = 0;
+
+                    for (auto& slot : coalescedSlots)
+                    {
+                        slot.inputs.setSize (numInputChannels, coalescedBlockSize);
+                        slot.inputs.clear();
+                        slot.outputs.setSize (numOutputChannels, coalescedBlockSize);
+                        slot.outputs.clear();
+                    }
+
+                    captureSlot = 0;
+                    renderSlot = 1;
+                    playbackSlot = 2;
+                }
+
+                // Blocks are timed against the hardware periods python has to render them: one hardware period when
+                // called directly, or the aggregated block of periods until the rendered block is due when coalescing
+                deadlineMonitor.prepare (device->getCurrentSampleRate(), coalescedBlockSize > 0 ? coalescedBlockSize : hardwareBlockSize, numOutputChannels);
+            }
+
+            coalescingLatency.store (2 * juce::jmax (0, coalescedBlockSize), std::memory_order_relaxed);
+        }
+
+        if (coalescedBlockSize > 0)
+        {
+            renderThread = std::make_unique<CoalescedRenderThread> (*this);
+            renderThread->startThread();
+        }
+
         PYBIND11_OVERRIDE_PURE (void, Base, audioDeviceAboutToStart, device);
     }
 
     void audioDeviceStopped() override
     {
+        stopCoalescedRendering();
+
         PYBIND11_OVERRIDE_PURE (void, Base, audioDeviceStopped);
     }
 
@@ -144,7 +367,265 @@ struct PyAudioIODeviceCallback : Base
     }
 
 private:
+    /** Called on the audio thread when the capture slot is full, hands it over to the render thread. */
+    void dispatchCoalescedBlock() noexcept
+    {
+        if (isRendering.load (std::memory_order_acquire))
+        {
+            // Python is still rendering the previous block, play silence and capture the next inputs over the same slot
+            numLateCoalescedBlocks.fetch_add (1, std::memory_order_relaxed);
+            coalescedSlots[static_cast<size_t> (playbackSlot)].outputs.clear();
+            return;
+        }
+
+        const auto playedSlot = playbackSlot;
+        playbackSlot = renderSlot;
+        renderSlot = captureSlot;
+        captureSlot = playedSlot;
+
+        isRendering.store (true, std::memory_order_release);
+        renderRequested.signal();
+    }
+
+    /** Called on the render thread, lets python process the slot handed over by the audio thread. */
+    void renderCoalescedBlock()
+    {
+        if (! isRendering.load (std::memory_order_acquire))
+            return;
+
+        auto& slot = coalescedSlots[static_cast<size_t> (renderSlot)];
+
+        juce::AudioIODeviceCallbackContext context;
+        context.hostTimeNs = slot.hasHostTime ? &slot.hostTimeNs : nullptr;
+
+        processBlock (slot.inputs.getArrayOfReadPointers(), slot.inputs.getNumChannels(),
+                      slot.outputs.getArrayOfWritePointers(), slot.outputs.getNumChannels(),
+                      coalescedBlockSize, context);
+
+        isRendering.store (false, std::memory_order_release);
+    }
+
+    void stopCoalescedRendering()
+    {
+        if (renderThread == nullptr)
+            return;
+
+        // The render thread might be waiting for the GIL to call python, so it must be released while joining
+        const auto stopRenderThread = [this]
+        {
+            renderThread->signalThreadShouldExit();
+            renderRequested.signal();
+            renderThread->stopThread (-1);
+        };
+
+        if (PyGILState_Check())
+        {
+            pybind11::gil_scoped_release release;
+            stopRenderThread();
+        }
+        else
+        {
+            stopRenderThread();
+        }
+
+        renderThread.reset();
+        isRendering.store (false, std::memory_order_relaxed);
+    }
+
+    void processBlock (const float* const* inputChannelData,
+                       int numInputChannels,
+                       float* const* outputChannelData,
+                       int numOutputChannels,
+                       int numSamples,
+                       const juce::AudioIODeviceCallbackContext& context)
+    {
+        const auto isMonitored = deadlineMonitor.isEnabled();
+
+        if (isMonitored && ! deadlineMonitor.beginCallback())
+        {
+            if (deadlineMonitor.getFallbackPolicy() == PyCallbackDeadlineMonitor::FallbackPolicy::bypass)
+            {
+                if constexpr (! std::is_abstract_v<Base>)
+                    return Base::audioDeviceIOCallbackWithContext (inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples, context);
+            }
+
+            deadlineMonitor.applyFallback (outputChannelData, numOutputChannels, 0, numSamples);
+            return;
+        }
+
+        const auto startTime = isMonitored ? juce::Time::getMillisecondCounterHiRes() : 0.0;
+
+        if (! invokeAudioDeviceIOCallback (inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples, context))
+            return;
+
+        if (isMonitored)
+        {
+            deadlineMonitor.endCallback (juce::Time::getMillisecondCounterHiRes() - startTime, numSamples);
+            deadlineMonitor.storeBlock (outputChannelData, numOutputChannels, 0, numSamples);
+        }
+    }
+
+    /** Dispatches the block to the python override, returns false if there is none and the native base was used. */
+    bool invokeAudioDeviceIOCallback (const float* const* inputChannelData,
+                                      int numInputChannels,
+                                      float* const* outputChannelData,
+                                      int numOutputChannels,
+                                      int numSamples,
+                                      const juce::AudioIODeviceCallbackContext& context)
+    {
+        pybind11::gil_scoped_acquire gil;
+
+        int numAllocations = prepareCallbackObjects();
+
+        if (! override_)
+        {
+            registerCallbackAllocations (numAllocations);
+
+            if constexpr (! std::is_abstract_v<Base>)
+            {
+                pybind11::gil_scoped_release release;
+                Base::audioDeviceIOCallbackWithContext (inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples, context);
+            }
+
+            return false;
+        }
+
+        numAllocations += inputViews.update (inputChannelData, static_cast<size_t> (numInputChannels), static_cast<size_t> (numSamples));
+        numAllocations += outputViews.update (outputChannelData, static_cast<size_t> (numOutputChannels), static_cast<size_t> (numSamples));
+
+        numAllocations += updateIntObject (numInputChannelsObject, lastNumInputChannels, numInputChannels);
+        numAllocations += updateIntObject (numOutputChannelsObject, lastNumOutputChannels, numOutputChannels);
+        numAllocations += updateIntObject (numSamplesObject, lastNumSamples, numSamples);
+
+        *contextView = context;
+
+        registerCallbackAllocations (numAllocations);
+
+        // The arguments are borrowed from the cached objects, so calling doesn't build an argument tuple
+        const std::array<PyObject*, 7> arguments
+        {
+            overrideSelf.ptr(),
+            inputViews.getList().ptr(),
+            numInputChannelsObject.ptr(),
+            outputViews.getList().ptr(),
+            numOutputChannelsObject.ptr(),
+            numSamplesObject.ptr(),
+            contextObject.ptr()
+        };
+
+       #if PY_VERSION_HEX >= 0x03090000
+        auto result = PyObject_Vectorcall (override_.ptr(), arguments.data(), arguments.size(), nullptr);
+       #else
+        auto result = _PyObject_FastCall (override_.ptr(), const_cast<PyObject**> (arguments.data()), static_cast<Py_ssize_t> (arguments.size()));
+       #endif
+
+        if (result == nullptr)
+            throw pybind11::error_already_set();
+
+        Py_DECREF (result);
+        return true;
+    }
+
+    static int updateIntObject (pybind11::object& object, int& lastValue, int value)
+    {
+        if (object && value == lastValue)
+            return 0;
+
+        object = pybind11::int_ (value);
+        lastValue = value;
+        return 1;
+    }
+
+    int prepareCallbackObjects()
+    {
+        int numAllocations = 0;
+
+        if (! hasLookedUpOverride)
+        {
+            // Only the unbound function is kept, holding the bound method would keep the instance owning this alive
+            const auto override = pybind11::get_override (static_cast<Base*> (this), "audioDeviceIOCallbackWithContext");
+
+            if (override && PyMethod_Check (override.ptr()))
+            {
+                override_ = pybind11::reinterpret_borrow<pybind11::function> (PyMethod_GET_FUNCTION (override.ptr()));
+                overrideSelf = PyMethod_GET_SELF (override.ptr());
+            }
+            else
+            {
+                override_ = pybind11::function();
+                overrideSelf = {};
+            }
+
+            hasLookedUpOverride = true;
+        }
+
+        if (! contextObject)
+        {
+            contextObject = pybind11::cast (juce::AudioIODeviceCallbackContext{});
+            contextView = contextObject.cast<juce::AudioIODeviceCallbackContext*>();
+            ++numAllocations;
+        }
+
+        return numAllocations;
+    }
+
     pybind11::function override_;
+    pybind11::handle overrideSelf;
+    bool hasLookedUpOverride = false;
+
+    PyChannelViewList<const float> inputViews;
+    PyChannelViewList<float> outputViews;
+
+    pybind11::object contextObject;
+    juce::AudioIODeviceCallbackContext* contextView = nullptr;
+
+    pybind11::object numInputChannelsObject;
+    pybind11::object numOutputChannelsObject;
+    pybind11::object numSamplesObject;
+    int lastNumInputChannels = -1;
+    int lastNumOutputChannels = -1;
+    int lastNumSamples = -1;
+
+    struct CoalescedSlot
+    {
+        juce::AudioBuffer<float> inputs;
+        juce::AudioBuffer<float> outputs;
+        std::uint64_t hostTimeNs = 0;
+        bool hasHostTime = false;
+    };
+
+    class CoalescedRenderThread : public juce::Thread
+    {
+    public:
+        explicit CoalescedRenderThread (PyAudioIODeviceCallback& owner)
+            : juce::Thread ("Python Coalesced Render")
+            , owner (owner)
+        {
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                if (owner.renderRequested.wait (100))
+                    owner.renderCoalescedBlock();
+            }
+        }
+
+    private:
+        PyAudioIODeviceCallback& owner;
+    };
+
+    std::array<CoalescedSlot, 3> coalescedSlots;
+    int captureSlot = 0;
+    int renderSlot = 1;
+    int playbackSlot = 2;
+    int coalescedBlockSize = 0;
+    int coalescedPosition = 0;
+
+    std::unique_ptr<CoalescedRenderThread> renderThread;
+    juce::WaitableEvent renderRequested;
+    std::atomic<bool> isRendering { false };
 };
 
 // =================================================================================================
@@ -17,18 +17,1948 @@
  */
 
 #include "ScriptJuceAudioFormatsBindings.h"
+#include "../utilities/ClassDemangling.h"
+
+#if JUCE_MODULE_AVAILABLE_juce_events
+ #include <juce_events/juce_events.h>
+#endif
 
 namespace popsicle::Bindings {
 
-using namespace juce;
+using namespace juce;
+
+namespace py = pybind11;
+using namespace py::literals;
+
+// ============================================================================================
+
+/**
+ * @brief Reads samples from a reader into planar channels of float, or of left-justified integers of any width.
+ */
+template <class T>
+bool readAudioFormatReaderSamples (AudioFormatReader& reader, T* const* destChannels, int numDestChannels, int64 startSampleInFile, int numSamples)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        return reader.read (destChannels, numDestChannels, startSampleInFile, numSamples);
+    }
+    else if constexpr (std::is_same_v<T, int>)
+    {
+        return reader.read (destChannels, numDestChannels, startSampleInFile, numSamples, false);
+    }
+    else
+    {
+        // Narrower integers are read as left-justified 32 bit integers a block at a time, keeping their most significant bits
+        constexpr int blockSize = 4096;
+        constexpr int shift = 32 - 8 * static_cast<int> (sizeof (T));
+
+        std::vector<int> block (static_cast<size_t> (blockSize) * static_cast<size_t> (numDestChannels));
+        std::vector<int*> blockChannels (static_cast<size_t> (numDestChannels));
+
+        for (int channel = 0; channel < numDestChannels; ++channel)
+            blockChannels[static_cast<size_t> (channel)] = block.data() + static_cast<size_t> (channel) * blockSize;
+
+        bool wasRead = true;
+
+        for (int offset = 0; offset < numSamples; offset += blockSize)
+        {
+            const auto numToRead = jmin (blockSize, numSamples - offset);
+
+            wasRead = reader.read (blockChannels.data(), numDestChannels, startSampleInFile + offset, numToRead, false) && wasRead;
+
+            for (int channel = 0; channel < numDestChannels; ++channel)
+            {
+                const auto source = blockChannels[static_cast<size_t> (channel)];
+                const auto dest = destChannels[channel] + offset;
+
+                for (int index = 0; index < numToRead; ++index)
+                    dest[index] = static_cast<T> (source[index] >> shift);
+            }
+        }
+
+        return wasRead;
+    }
+}
+
+template <class T>
+bool readAudioFormatReaderIntoBuffer (AudioFormatReader& reader, const py::buffer_info& info, int64 startSampleInFile)
+{
+    if (! std::is_same_v<T, float> && reader.usesFloatingPointData)
+        py::pybind11_fail ("Reader holds floating point samples, which can only be read into a float32 buffer");
+
+    int numSamples = 0;
+    const auto channels = getBufferChannelPointers<T> (info, numSamples);
+
+    py::gil_scoped_release release;
+    return readAudioFormatReaderSamples (reader, channels.data(), static_cast<int> (channels.size()), startSampleInFile, numSamples);
+}
+
+bool readAudioFormatReaderInto (AudioFormatReader& reader, py::buffer dest, int64 startSampleInFile)
+{
+    const auto info = dest.request (true);
+
+    if (isBufferOfType<float> (info))
+        return readAudioFormatReaderIntoBuffer<float> (reader, info, startSampleInFile);
+
+    if (isBufferOfType<int> (info))
+        return readAudioFormatReaderIntoBuffer<int> (reader, info, startSampleInFile);
+
+    if (isBufferOfType<int16> (info))
+        return readAudioFormatReaderIntoBuffer<int16> (reader, info, startSampleInFile);
+
+    if (isBufferOfType<int8> (info))
+        return readAudioFormatReaderIntoBuffer<int8> (reader, info, startSampleInFile);
+
+    py::pybind11_fail ("Buffer must hold float32, int32, int16 or int8 samples");
+}
+
+int getAudioFormatReaderNumSamples (const AudioFormatReader& reader, int64 startSampleInFile, int64 numSamples)
+{
+    if (startSampleInFile < 0 || startSampleInFile > reader.lengthInSamples)
+        py::pybind11_fail ("Start sample is outside of the reader length");
+
+    if (numSamples < 0)
+        numSamples = reader.lengthInSamples - startSampleInFile;
+
+    if (numSamples > std::numeric_limits<int>::max())
+        py::pybind11_fail ("Too many samples to read at once");
+
+    return static_cast<int> (numSamples);
+}
+
+template <class T>
+py::object readAllFromAudioFormatReader (AudioFormatReader& reader, int64 startSampleInFile, int numSamples)
+{
+    AudioSampleArray<T> result (static_cast<int> (reader.numChannels), numSamples);
+    const auto channels = result.getChannelPointers();
+
+    bool wasRead = false;
+
+    {
+        py::gil_scoped_release release;
+        wasRead = readAudioFormatReaderSamples (reader, channels.data(), result.numChannels, startSampleInFile, result.numSamples);
+    }
+
+    if (! wasRead)
+        py::pybind11_fail ("Unable to read samples from the audio format reader");
+
+    return py::cast (std::move (result));
+}
+
+/**
+ * @brief Finds the min and max of many consecutive columns of samples in a single sequential pass over the reader.
+ *
+ * Columns span samplesPerColumn samples each, but never less than one, and columns outside of the reader are left as
+ * silence.
+ */
+AudioPeakArray readMaxLevelsBatch (AudioFormatReader& reader, int64 startSample, double samplesPerColumn, int numColumns)
+{
+    if (! (samplesPerColumn > 0.0) || ! std::isfinite (samplesPerColumn))
+        py::pybind11_fail ("Samples per column must be a positive number");
+
+    if (numColumns < 0)
+        py::pybind11_fail ("Number of columns must not be negative");
+
+    const auto numChannels = static_cast<int> (reader.numChannels);
+    AudioPeakArray result (numChannels, numColumns, 2);
+
+    if (numColumns == 0 || numChannels == 0)
+        return result;
+
+    const auto getColumnStart = [&] (int column)
+    {
+        return startSample + static_cast<int64> (std::floor (column * samplesPerColumn));
+    };
+
+    const auto getColumnEnd = [&] (int column)
+    {
+        return jmax (getColumnStart (column) + 1, startSample + static_cast<int64> (std::floor ((column + 1) * samplesPerColumn)));
+    };
+
+    const auto firstSample = jmax<int64> (0, startSample);
+    const auto lastSample = jmin (reader.lengthInSamples, getColumnEnd (numColumns - 1));
+
+    bool wasRead = true;
+
+    {
+        py::gil_scoped_release release;
+
+        constexpr int blockSize = 65536;
+        AudioBuffer<float> block (numChannels, blockSize);
+        std::vector<bool> hasLevels (static_cast<size_t> (numColumns), false);
+
+        int firstColumn = 0;
+
+        for (auto blockStart = firstSample; blockStart < lastSample; blockStart += blockSize)
+        {
+            const auto numSamples = static_cast<int> (jmin (static_cast<int64> (blockSize), lastSample - blockStart));
+            const auto blockEnd = blockStart + numSamples;
+
+            wasRead = reader.read (block.getArrayOfWritePointers(), numChannels, blockStart, numSamples) && wasRead;
+
+            while (firstColumn < numColumns && getColumnEnd (firstColumn) <= blockStart)
+                ++firstColumn;
+
+            for (auto column = firstColumn; column < numColumns && getColumnStart (column) < blockEnd; ++column)
+            {
+                const auto start = jmax (getColumnStart (column), blockStart);
+                const auto end = jmin (getColumnEnd (column), blockEnd);
+
+                if (end <= start)
+                    continue;
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    const auto range = FloatVectorOperations::findMinAndMax (block.getReadPointer (channel, static_cast<int> (start - blockStart)), static_cast<int> (end - start));
+                    auto levels = result.getColumn (channel, column);
+
+                    // Columns spanning more blocks are merged with what was found in the previous ones
+                    levels[0] = hasLevels[static_cast<size_t> (column)] ? jmin (levels[0], range.getStart()) : range.getStart();
+                    levels[1] = hasLevels[static_cast<size_t> (column)] ? jmax (levels[1], range.getEnd()) : range.getEnd();
+                }
+
+                hasLevels[static_cast<size_t> (column)] = true;
+            }
+        }
+    }
+
+    if (! wasRead)
+        py::pybind11_fail ("Unable to read samples from the audio format reader");
+
+    return result;
+}
+
+// ============================================================================================
+
+struct AudioFileDecodeOptions
+{
+    int numChannels = -1;
+    int64 startSample = 0;
+    int64 numSamples = -1;
+    double sampleRate = 0.0;
+    ResamplingQuality quality = ResamplingQuality::windowedSinc;
+};
+
+struct AudioFileDecodeInfo
+{
+    String error;
+    double sourceSampleRate = 0.0;
+    int numSourceChannels = 0;
+    int64 lengthInSamples = 0;
+    int64 startSample = 0;
+    int numSourceSamples = 0;
+    double sampleRate = 0.0;
+    int numChannels = 0;
+    int numSamples = 0;
+    int64 offset = 0;
+};
+
+struct AudioFileDecodeResult
+{
+    py::object samples;
+    AudioFileDecodeInfo info;
+};
+
+/**
+ * @brief Decodes audio files to float samples, optionally remapping channels and resampling, from any thread.
+ *
+ * Mono targets average all the source channels, narrower targets keep the first channels and wider targets repeat the
+ * source channels cyclically.
+ */
+struct AudioFileDecoder
+{
+    static std::unique_ptr<AudioFormatReader> openReader (AudioFormatManager& manager, const File& file, const AudioFileDecodeOptions& options, AudioFileDecodeInfo& info)
+    {
+        std::unique_ptr<AudioFormatReader> reader (manager.createReaderFor (file));
+        if (reader == nullptr)
+        {
+            info.error = "Unable to open the file or unsupported audio format";
+            return {};
+        }
+
+        info.sourceSampleRate = reader->sampleRate;
+        info.numSourceChannels = static_cast<int> (reader->numChannels);
+        info.lengthInSamples = reader->lengthInSamples;
+
+        if (options.startSample < 0 || options.startSample > reader->lengthInSamples)
+        {
+            info.error = "Start sample is outside of the file length";
+            return {};
+        }
+
+        const auto numAvailable = reader->lengthInSamples - options.startSample;
+        const auto numSourceSamples = options.numSamples < 0 ? numAvailable : jmin (options.numSamples, numAvailable);
+        if (numSourceSamples > std::numeric_limits<int>::max())
+        {
+            info.error = "File contains too many samples to decode at once";
+            return {};
+        }
+
+        info.startSample = options.startSample;
+        info.numSourceSamples = static_cast<int> (numSourceSamples);
+        info.numChannels = options.numChannels > 0 ? options.numChannels : info.numSourceChannels;
+        info.sampleRate = options.sampleRate > 0.0 ? options.sampleRate : info.sourceSampleRate;
+        info.numSamples = needsResampling (info)
+            ? AudioResampler::getNumOutputSamples (info.numSourceSamples, info.sourceSampleRate / info.sampleRate)
+            : info.numSourceSamples;
+
+        return reader;
+    }
+
+    static bool decode (AudioFormatReader& reader, const AudioFileDecodeInfo& info, const AudioFileDecodeOptions& options, float* const* destChannels)
+    {
+        if (! needsResampling (info) && info.numChannels == info.numSourceChannels)
+            return readAudioFormatReaderSamples (reader, destChannels, info.numChannels, info.startSample, info.numSamples);
+
+        AudioSampleArray<float> source (info.numSourceChannels, info.numSourceSamples);
+        auto sourceChannels = source.getChannelPointers();
+
+        if (! readAudioFormatReaderSamples (reader, sourceChannels.data(), source.numChannels, info.startSample, source.numSamples))
+            return false;
+
+        std::optional<AudioSampleArray<float>> resampled;
+        if (needsResampling (info))
+        {
+            resampled.emplace (info.numSourceChannels, info.numSamples);
+            const auto resampledChannels = resampled->getChannelPointers();
+
+            std::vector<AudioResampler::Job> jobs;
+            AudioResampler::addJobs (jobs, std::vector<const float*> (sourceChannels.begin(), sourceChannels.end()), source.numSamples, resampledChannels, info.numSamples, info.sourceSampleRate / info.sampleRate);
+            AudioResampler::process (jobs, options.quality, 1);
+
+            sourceChannels = resampledChannels;
+        }
+
+        remapChannels (sourceChannels, destChannels, info.numChannels, info.numSamples);
+        return true;
+    }
+
+    static void remapChannels (const std::vector<float*>& sourceChannels, float* const* destChannels, int numDestChannels, int numSamples) noexcept
+    {
+        const auto numSourceChannels = static_cast<int> (sourceChannels.size());
+
+        if (numSourceChannels == 0)
+        {
+            for (int channel = 0; channel < numDestChannels; ++channel)
+                FloatVectorOperations::clear (destChannels[channel], numSamples);
+
+            return;
+        }
+
+        if (numDestChannels == 1 && numSourceChannels > 1)
+        {
+            FloatVectorOperations::copy (destChannels[0], sourceChannels[0], numSamples);
+
+            for (int channel = 1; channel < numSourceChannels; ++channel)
+                FloatVectorOperations::add (destChannels[0], sourceChannels[static_cast<size_t> (channel)], numSamples);
+
+            FloatVectorOperations::multiply (destChannels[0], 1.0f / static_cast<float> (numSourceChannels), numSamples);
+            return;
+        }
+
+        for (int channel = 0; channel < numDestChannels; ++channel)
+            FloatVectorOperations::copy (destChannels[channel], sourceChannels[static_cast<size_t> (channel % numSourceChannels)], numSamples);
+    }
+
+private:
+    static bool needsResampling (const AudioFileDecodeInfo& info) noexcept
+    {
+        return info.sourceSampleRate > 0.0 && ! approximatelyEqual (info.sourceSampleRate, info.sampleRate);
+    }
+};
+
+File getFileFromObject (py::handle object)
+{
+    if (py::isinstance<File> (object))
+        return object.cast<File>();
+
+    return File (py::module_::import ("os").attr ("fspath") (object).cast<String>());
+}
+
+std::vector<File> getFilesFromList (const py::list& files)
+{
+    std::vector<File> result;
+    result.reserve (files.size());
+
+    for (const auto& file : files)
+        result.push_back (getFileFromObject (file));
+
+    return result;
+}
+
+py::list createAudioFileDecodeResults (std::vector<AudioFileDecodeInfo>& infos, std::vector<std::optional<AudioSampleArray<float>>>* samples)
+{
+    py::list results;
+
+    for (size_t index = 0; index < infos.size(); ++index)
+    {
+        AudioFileDecodeResult result;
+        result.info = std::move (infos[index]);
+
+        if (samples != nullptr && (*samples)[index].has_value())
+            result.samples = py::cast (std::move (*(*samples)[index]));
+
+        results.append (py::cast (std::move (result)));
+    }
+
+    return results;
+}
+
+py::list decodeAudioFiles (AudioFormatManager& manager, const py::list& files, const AudioFileDecodeOptions& options, int numThreads)
+{
+    const auto filesToDecode = getFilesFromList (files);
+
+    std::vector<AudioFileDecodeInfo> infos (filesToDecode.size());
+    std::vector<std::optional<AudioSampleArray<float>>> samples (filesToDecode.size());
+
+    {
+        py::gil_scoped_release release;
+
+        parallelFor ("AudioFileDecoder", filesToDecode.size(), numThreads, [&] (size_t index)
+        {
+            auto& info = infos[index];
+
+            try
+            {
+                auto reader = AudioFileDecoder::openReader (manager, filesToDecode[index], options, info);
+                if (reader == nullptr)
+                    return;
+
+                auto& result = samples[index].emplace (info.numChannels, info.numSamples);
+                const auto channels = result.getChannelPointers();
+
+                if (! AudioFileDecoder::decode (*reader, info, options, channels.data()))
+                {
+                    info.error = "Unable to decode the audio file";
+                    samples[index].reset();
+                }
+            }
+            catch (const std::exception& e)
+            {
+                info.error = e.what();
+                samples[index].reset();
+            }
+        });
+    }
+
+    return createAudioFileDecodeResults (infos, &samples);
+}
+
+py::list decodeAudioFilesInto (AudioFormatManager& manager, const py::list& files, py::buffer dest, AudioFileDecodeOptions options, int numThreads)
+{
+    const auto filesToDecode = getFilesFromList (files);
+
+    const auto destInfo = dest.request (true);
+
+    int destCapacity = 0;
+    const auto destChannels = getBufferChannelPointers<float> (destInfo, destCapacity);
+    options.numChannels = static_cast<int> (destChannels.size());
+
+    std::vector<AudioFileDecodeInfo> infos (filesToDecode.size());
+
+    {
+        py::gil_scoped_release release;
+
+        const auto probe = [&] (size_t index)
+        {
+            try
+            {
+                AudioFileDecoder::openReader (manager, filesToDecode[index], options, infos[index]);
+            }
+            catch (const std::exception& e)
+            {
+                infos[index].error = e.what();
+            }
+        };
+
+        parallelFor ("AudioFileDecoder", filesToDecode.size(), numThreads, probe);
+
+        // Files are laid out one after the other, skipping the ones that failed to open or don't fit anymore
+        int64 offset = 0;
+        for (auto& info : infos)
+        {
+            if (info.error.isNotEmpty())
+                continue;
+
+            if (offset + info.numSamples > destCapacity)
+            {
+                info.error = "Not enough space left in the destination buffer";
+                continue;
+            }
+
+            info.offset = offset;
+            offset += info.numSamples;
+        }
+
+        parallelFor ("AudioFileDecoder", filesToDecode.size(), numThreads, [&] (size_t index)
+        {
+            auto& info = infos[index];
+            if (info.error.isNotEmpty())
+                return;
+
+            try
+            {
+                AudioFileDecodeInfo reopenedInfo;
+                auto reader = AudioFileDecoder::openReader (manager, filesToDecode[index], options, reopenedInfo);
+
+                if (reader == nullptr || reopenedInfo.numSamples != info.numSamples)
+                {
+                    info.error = reader == nullptr ? reopenedInfo.error : String ("The audio file changed while decoding");
+                    return;
+                }
+
+                std::vector<float*> channels (destChannels.size());
+                for (size_t channel = 0; channel < channels.size(); ++channel)
+                    channels[channel] = destChannels[channel] + info.offset;
+
+                if (! AudioFileDecoder::decode (*reader, info, options, channels.data()))
+                    info.error = "Unable to decode the audio file";
+            }
+            catch (const std::exception& e)
+            {
+                info.error = e.what();
+            }
+        });
+    }
+
+    return createAudioFileDecodeResults (infos, nullptr);
+}
+
+// ============================================================================================
+
+struct AudioTranscodeJob
+{
+    File sourceFile;
+    File destFile;
+    py::object format = py::none();
+    double sampleRate = 0.0;
+    int numChannels = -1;
+    int bitsPerSample = 16;
+    int qualityOptionIndex = 0;
+    StringPairArray metadataValues;
+};
+
+/**
+ * @brief Converts files between formats, rates and channel counts on a pool of workers, without holding the GIL.
+ *
+ * Each job decodes through a BufferingAudioReader on its own TimeSliceThread, while the worker resamples with a
+ * ResamplingAudioSource, remaps the channels like AudioFileDecoder and encodes. Progress and completion callbacks are
+ * posted to the message thread, so they only run while a message loop is dispatching.
+ */
+class AudioTranscoder
+{
+public:
+    AudioTranscoder (AudioFormatManager& managerToUse, int numThreads, int blockSizeToUse)
+        : manager (managerToUse)
+        , blockSize (blockSizeToUse)
+    {
+        if (blockSize <= 0)
+            py::pybind11_fail ("Block size must be greater than zero");
+
+        pool = std::make_unique<ThreadPool> (ThreadPoolOptions{}
+            .withThreadName ("AudioTranscoder")
+            .withNumberOfThreads (numThreads > 0 ? numThreads : SystemStats::getNumCpus()));
+
+        finished.signal();
+    }
+
+    ~AudioTranscoder()
+    {
+        // Workers might be waiting for the GIL to encode or decode through python formats
+        if (PyGILState_Check())
+        {
+            py::gil_scoped_release release;
+            stop();
+        }
+        else
+        {
+            stop();
+        }
+    }
+
+    void start (const std::vector<AudioTranscodeJob>& jobsToRun, py::object progressCallback, py::object completionCallback)
+    {
+        if (isRunning())
+            py::pybind11_fail ("Transcoder is already running");
+
+        jobs = jobsToRun;
+        formats.clear();
+
+        for (const auto& job : jobs)
+        {
+            if (job.format.is_none())
+                py::pybind11_fail ("Transcode job has no target audio format");
+
+            formats.push_back (job.format.cast<AudioFormat*>());
+        }
+
+        callbacks = std::make_shared<Callbacks>();
+        callbacks->progress = std::move (progressCallback);
+        callbacks->completion = std::move (completionCallback);
+
+        errors.assign (jobs.size(), String());
+        progress = std::make_unique<std::atomic<float>[]> (jobs.size());
+        for (size_t index = 0; index < jobs.size(); ++index)
+            progress[index].store (0.0f, std::memory_order_relaxed);
+
+        shouldCancel.store (false, std::memory_order_relaxed);
+        numPendingJobs.store (jobs.size(), std::memory_order_relaxed);
+
+        if (jobs.empty())
+            return;
+
+        finished.reset();
+
+        for (size_t index = 0; index < jobs.size(); ++index)
+        {
+            pool->addJob ([this, index]
+            {
+                runJob (index);
+
+                if (--numPendingJobs == 0)
+                    finished.signal();
+            });
+        }
+    }
+
+    bool waitForCompletion (int timeoutMilliseconds)
+    {
+        return finished.wait (timeoutMilliseconds);
+    }
+
+    void cancel() noexcept
+    {
+        shouldCancel.store (true, std::memory_order_relaxed);
+    }
+
+    bool isRunning() const noexcept
+    {
+        return numPendingJobs.load (std::memory_order_acquire) > 0;
+    }
+
+    int getNumJobs() const noexcept
+    {
+        return static_cast<int> (jobs.size());
+    }
+
+    float getJobProgress (int index) const
+    {
+        if (! isPositiveAndBelow (index, getNumJobs()))
+            py::pybind11_fail ("Invalid transcode job index");
+
+        return progress[static_cast<size_t> (index)].load (std::memory_order_relaxed);
+    }
+
+    float getProgress() const noexcept
+    {
+        if (jobs.empty())
+            return 1.0f;
+
+        float total = 0.0f;
+        for (size_t index = 0; index < jobs.size(); ++index)
+            total += progress[index].load (std::memory_order_relaxed);
+
+        return total / static_cast<float> (jobs.size());
+    }
+
+    const std::vector<String>& getErrors() const
+    {
+        if (isRunning())
+            py::pybind11_fail ("Transcoder is still running");
+
+        return errors;
+    }
+
+private:
+    struct Callbacks
+    {
+        ~Callbacks()
+        {
+            py::gil_scoped_acquire gil;
+            progress = py::object();
+            completion = py::object();
+        }
+
+        py::object progress;
+        py::object completion;
+    };
+
+    void stop()
+    {
+        cancel();
+        finished.wait (-1);
+    }
+
+    void runJob (size_t index)
+    {
+        float lastPostedProgress = 0.0f;
+
+        const auto reportProgress = [&] (float newProgress)
+        {
+            progress[index].store (newProgress, std::memory_order_relaxed);
+
+            if (newProgress - lastPostedProgress >= 0.01f)
+            {
+                lastPostedProgress = newProgress;
+                postCallback (&Callbacks::progress, index, newProgress);
+            }
+        };
+
+        try
+        {
+            errors[index] = transcode (jobs[index], *formats[index], reportProgress);
+        }
+        catch (const std::exception& e)
+        {
+            errors[index] = e.what();
+        }
+
+        if (errors[index].isEmpty())
+            progress[index].store (1.0f, std::memory_order_relaxed);
+
+        postCallback (&Callbacks::completion, index, errors[index]);
+    }
+
+    template <class T>
+    void postCallback (py::object Callbacks::* callback, size_t index, T value)
+    {
+#if JUCE_MODULE_AVAILABLE_juce_events
+        MessageManager::callAsync ([callbacks = callbacks, callback, index, value]
+        {
+            py::gil_scoped_acquire gil;
+
+            if (const auto& function = (*callbacks).*callback; ! function.is_none())
+            {
+                try
+                {
+                    function (index, value);
+                }
+                catch (const py::error_already_set& e)
+                {
+                    Helpers::printPythonException (e);
+                }
+            }
+        });
+#else
+        ignoreUnused (callback, index, value);
+#endif
+    }
+
+    template <class F>
+    String transcode (const AudioTranscodeJob& job, AudioFormat& format, F&& reportProgress)
+    {
+        std::unique_ptr<AudioFormatReader> reader (manager.createReaderFor (job.sourceFile));
+        if (reader == nullptr)
+            return "Unable to open the source file or unsupported audio format";
+
+        const auto numSourceChannels = static_cast<int> (reader->numChannels);
+        const auto numChannels = job.numChannels > 0 ? job.numChannels : numSourceChannels;
+        const auto sampleRate = job.sampleRate > 0.0 ? job.sampleRate : reader->sampleRate;
+        const auto speedRatio = reader->sampleRate / sampleRate;
+        const auto needsResampling = ! approximatelyEqual (speedRatio, 1.0);
+        const auto numOutputSamples = static_cast<int64> (std::ceil (static_cast<double> (reader->lengthInSamples) / speedRatio - 1.0e-6));
+
+        // Encoding goes to a sibling temporary file, so a cancelled or failed job never leaves a truncated output behind
+        TemporaryFile temporaryFile (job.destFile);
+
+        std::unique_ptr<FileOutputStream> stream (temporaryFile.getFile().createOutputStream());
+        if (stream == nullptr)
+            return "Unable to create the destination file";
+
+        std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (stream.get(), sampleRate, static_cast<unsigned int> (numChannels),
+                                                                           job.bitsPerSample, job.metadataValues, job.qualityOptionIndex));
+        if (writer == nullptr)
+            return "Target format can't write the requested sample rate, channels or bit depth";
+
+        stream.release();
+
+        // Decoding runs ahead on its own thread, overlapping with resampling and encoding on this one
+        TimeSliceThread decodeThread ("AudioTranscoderDecoder");
+        decodeThread.startThread();
+
+        auto bufferingReader = new BufferingAudioReader (reader.release(), decodeThread, blockSize * 8);
+        bufferingReader->setReadTimeout (-1);
+
+        AudioFormatReaderSource readerSource (bufferingReader, true);
+        ResamplingAudioSource resampler (&readerSource, false, numSourceChannels);
+        resampler.setResamplingRatio (speedRatio);
+        resampler.prepareToPlay (blockSize, sampleRate);
+
+        AudioSource& source = needsResampling ? static_cast<AudioSource&> (resampler) : static_cast<AudioSource&> (readerSource);
+
+        AudioBuffer<float> sourceBlock (numSourceChannels, blockSize);
+        AudioBuffer<float> destBlock (numChannels, blockSize);
+        const std::vector<float*> sourceChannels (sourceBlock.getArrayOfWritePointers(), sourceBlock.getArrayOfWritePointers() + numSourceChannels);
+
+        for (int64 position = 0; position < numOutputSamples;)
+        {
+            if (shouldCancel.load (std::memory_order_relaxed))
+                return "Transcoding was cancelled";
+
+            const auto numSamples = static_cast<int> (jmin (static_cast<int64> (blockSize), numOutputSamples - position));
+
+            source.getNextAudioBlock (AudioSourceChannelInfo (&sourceBlock, 0, numSamples));
+            AudioFileDecoder::remapChannels (sourceChannels, destBlock.getArrayOfWritePointers(), numChannels, numSamples);
+
+            if (! writer->writeFromAudioSampleBuffer (destBlock, 0, numSamples))
+                return "Unable to write to the destination file";
+
+            position += numSamples;
+            reportProgress (static_cast<float> (static_cast<double> (position) / static_cast<double> (numOutputSamples)));
+        }
+
+        resampler.releaseResources();
+
+        // Finalises the header before the file is moved in place
+        writer.reset();
+
+        if (! temporaryFile.overwriteTargetFileWithTemporary())
+            return "Unable to replace the destination file";
+
+        return {};
+    }
+
+    AudioFormatManager& manager;
+    const int blockSize;
+
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<AudioTranscodeJob> jobs;
+    std::vector<AudioFormat*> formats;
+    std::vector<String> errors;
+    std::unique_ptr<std::atomic<float>[]> progress;
+    std::shared_ptr<Callbacks> callbacks;
+
+    std::atomic<bool> shouldCancel { false };
+    std::atomic<size_t> numPendingJobs { 0 };
+    WaitableEvent finished { true };
+};
+
+// ============================================================================================
+
+/**
+ * @brief A summary of one bin of one channel in a peak pyramid sidecar, stored as little endian 16 bit values.
+ */
+struct AudioPeakRecord
+{
+    static constexpr const char* format = "T{<h:min:h:max:h:rms:}";
+
+    int16 min = 0;
+    int16 max = 0;
+    int16 rms = 0;
+};
+
+static_assert (sizeof (AudioPeakRecord) == 6);
+
+struct AudioPeakLevelView
+{
+    std::shared_ptr<MemoryMappedFile> map;
+    const AudioPeakRecord* data = nullptr;
+    int64 numBins = 0;
+    int numChannels = 0;
+    int64 samplesPerBin = 0;
+};
+
+/**
+ * @brief Min, max and rms summaries of a file at power of two zoom levels, stored in a memory mapped sidecar file.
+ *
+ * The finest level summarises samplesPerBin samples per bin, and each following level halves the number of bins down
+ * to a single one. The sidecar remembers size, modification time and a fingerprint of the first and last 64KB of the
+ * source, so a stale sidecar is rebuilt instead of being served. Queries pick the level closest to the requested zoom,
+ * reading at most a few bins per pixel.
+ */
+class AudioPeakPyramid
+{
+public:
+    struct Level
+    {
+        int64 numBins = 0;
+        int64 dataOffset = 0;
+    };
+
+    int getNumChannels() const noexcept { return numChannels; }
+    int64 getLengthInSamples() const noexcept { return lengthInSamples; }
+    double getSampleRate() const noexcept { return sampleRate; }
+    int getNumLevels() const noexcept { return static_cast<int> (levels.size()); }
+
+    int64 getSamplesPerBin (int level) const
+    {
+        return getLevelSamplesPerBin (checkLevel (level));
+    }
+
+    int64 getNumBins (int level) const
+    {
+        return levels[static_cast<size_t> (checkLevel (level))].numBins;
+    }
+
+    AudioPeakLevelView getLevelView (int level) const
+    {
+        const auto& levelInfo = levels[static_cast<size_t> (checkLevel (level))];
+        return { map, getLevelData (level), levelInfo.numBins, numChannels, getLevelSamplesPerBin (level) };
+    }
+
+    void getPeaks (int64 startSample, int64 numSamples, AudioPeakArray& dest) const noexcept
+    {
+        if (dest.numColumns <= 0 || numSamples <= 0 || levels.empty())
+            return;
+
+        const auto samplesPerPixel = static_cast<double> (numSamples) / static_cast<double> (dest.numColumns);
+
+        int level = 0;
+        while (level + 1 < getNumLevels() && static_cast<double> (getLevelSamplesPerBin (level + 1)) <= samplesPerPixel)
+            ++level;
+
+        const auto binSize = static_cast<double> (getLevelSamplesPerBin (level));
+        const auto numBins = levels[static_cast<size_t> (level)].numBins;
+        const auto records = getLevelData (level);
+        const auto numChannelsToRead = jmin (numChannels, dest.numChannels);
+
+        for (int column = 0; column < dest.numColumns; ++column)
+        {
+            const auto columnStart = static_cast<double> (startSample) + column * samplesPerPixel;
+            const auto columnEnd = columnStart + samplesPerPixel;
+
+            if (columnEnd <= 0.0 || columnStart >= static_cast<double> (lengthInSamples))
+                continue;
+
+            const auto firstBin = jlimit<int64> (0, numBins - 1, static_cast<int64> (std::floor (columnStart / binSize)));
+            const auto lastBin = jlimit<int64> (firstBin + 1, numBins, static_cast<int64> (std::ceil (columnEnd / binSize)));
+
+            for (int channel = 0; channel < numChannelsToRead; ++channel)
+            {
+                int minimum = std::numeric_limits<int16>::max();
+                int maximum = std::numeric_limits<int16>::min();
+                double sumSquares = 0.0;
+
+                for (auto bin = firstBin; bin < lastBin; ++bin)
+                {
+                    const auto& record = records[bin * numChannels + channel];
+                    const auto rms = static_cast<double> (readValue (record.rms));
+
+                    minimum = jmin (minimum, static_cast<int> (readValue (record.min)));
+                    maximum = jmax (maximum, static_cast<int> (readValue (record.max)));
+                    sumSquares += rms * rms;
+                }
+
+                auto result = dest.getColumn (channel, column);
+                result[0] = static_cast<float> (minimum) / 32767.0f;
+                result[1] = static_cast<float> (maximum) / 32767.0f;
+
+                if (dest.numFields > 2)
+                    result[2] = static_cast<float> (std::sqrt (sumSquares / static_cast<double> (lastBin - firstBin)) / 32767.0);
+            }
+        }
+    }
+
+    static File getDefaultSidecarFile (const File& sourceFile)
+    {
+        return sourceFile.getSiblingFile (sourceFile.getFileName() + ".peaks");
+    }
+
+    static std::unique_ptr<AudioPeakPyramid> open (const File& sidecarFile, const File& sourceFile)
+    {
+        if (! sidecarFile.existsAsFile())
+            return {};
+
+        auto map = std::make_shared<MemoryMappedFile> (sidecarFile, MemoryMappedFile::readOnly, false);
+        if (map->getData() == nullptr)
+            return {};
+
+        MemoryInputStream stream (map->getData(), map->getSize(), false);
+
+        char magic[4] = {};
+        if (stream.read (magic, 4) != 4 || std::memcmp (magic, fileMagic, 4) != 0 || stream.readInt() != fileVersion)
+            return {};
+
+        const auto key = SourceKey::read (stream);
+        if (sourceFile != File() && ! (key == SourceKey::create (sourceFile)))
+            return {};
+
+        auto pyramid = std::unique_ptr<AudioPeakPyramid> (new AudioPeakPyramid());
+        pyramid->map = std::move (map);
+        pyramid->sampleRate = stream.readDouble();
+        pyramid->lengthInSamples = stream.readInt64();
+        pyramid->numChannels = stream.readInt();
+        pyramid->samplesPerBin = stream.readInt();
+
+        const auto numLevels = stream.readInt();
+        if (pyramid->numChannels <= 0 || pyramid->samplesPerBin <= 0 || numLevels <= 0 || numLevels > 63)
+            return {};
+
+        const auto mapSize = static_cast<int64> (pyramid->map->getSize());
+
+        for (int level = 0; level < numLevels; ++level)
+        {
+            Level levelInfo;
+            levelInfo.numBins = stream.readInt64();
+            levelInfo.dataOffset = stream.readInt64();
+
+            const auto numBytes = levelInfo.numBins * pyramid->numChannels * static_cast<int64> (sizeof (AudioPeakRecord));
+            if (levelInfo.numBins <= 0 || levelInfo.dataOffset < 0 || levelInfo.dataOffset + numBytes > mapSize || stream.isExhausted())
+                return {};
+
+            pyramid->levels.push_back (levelInfo);
+        }
+
+        return pyramid;
+    }
+
+    static void build (AudioFormatManager& manager, const File& sourceFile, const File& sidecarFile, int samplesPerBin, int numThreads)
+    {
+        if (samplesPerBin <= 0)
+            py::pybind11_fail ("Samples per bin must be greater than zero");
+
+        std::unique_ptr<AudioFormatReader> reader (manager.createReaderFor (sourceFile));
+        if (reader == nullptr)
+            py::pybind11_fail ("Unable to open the source file or unsupported audio format");
+
+        const auto key = SourceKey::create (sourceFile);
+        const auto numChannels = static_cast<int> (reader->numChannels);
+        const auto lengthInSamples = reader->lengthInSamples;
+        const auto sampleRate = reader->sampleRate;
+
+        if (numChannels <= 0)
+            py::pybind11_fail ("Source file has no audio channels");
+
+        std::vector<LevelData> levelData (1);
+        levelData[0].allocate (jmax<int64> (1, (lengthInSamples + samplesPerBin - 1) / samplesPerBin), numChannels);
+
+        std::atomic<bool> failed { false };
+
+        {
+            py::gil_scoped_release release;
+
+            // Chunks are summarised in parallel, each worker decoding a contiguous range of them through a single reader
+            constexpr int64 binsPerChunk = 1024;
+            const auto numChunks = static_cast<size_t> ((levelData[0].numBins + binsPerChunk - 1) / binsPerChunk);
+            const auto numRanges = jmin (numChunks, static_cast<size_t> (numThreads > 0 ? numThreads : SystemStats::getNumCpus()));
+
+            parallelFor ("AudioPeakPyramid", numRanges, numThreads, [&] (size_t range)
+            {
+                std::unique_ptr<AudioFormatReader> rangeReader (manager.createReaderFor (sourceFile));
+                if (rangeReader == nullptr)
+                {
+                    failed.store (true, std::memory_order_relaxed);
+                    return;
+                }
+
+                const auto maxSamplesPerChunk = static_cast<int> (jlimit<int64> (1, binsPerChunk * samplesPerBin, lengthInSamples));
+                AudioBuffer<float> buffer (numChannels, maxSamplesPerChunk);
+
+                const auto firstChunk = range * numChunks / numRanges;
+                const auto lastChunk = (range + 1) * numChunks / numRanges;
+
+                for (auto chunk = firstChunk; chunk < lastChunk; ++chunk)
+                {
+                    const auto firstBin = static_cast<int64> (chunk) * binsPerChunk;
+                    const auto lastBin = jmin (levelData[0].numBins, firstBin + binsPerChunk);
+                    const auto firstSample = firstBin * samplesPerBin;
+                    const auto numSamples = static_cast<int> (jlimit<int64> (0, (lastBin - firstBin) * samplesPerBin, lengthInSamples - firstSample));
+
+                    if (! rangeReader->read (buffer.getArrayOfWritePointers(), numChannels, firstSample, numSamples))
+                        failed.store (true, std::memory_order_relaxed);
+
+                    for (auto bin = firstBin; bin < lastBin; ++bin)
+                    {
+                        const auto offset = static_cast<int> ((bin - firstBin) * samplesPerBin);
+                        const auto numSamplesInBin = jlimit (0, samplesPerBin, numSamples - offset);
+
+                        for (int channel = 0; channel < numChannels; ++channel)
+                            levelData[0].summarise (bin, channel, buffer.getReadPointer (channel, offset), numSamplesInBin);
+                    }
+                }
+            });
+
+            for (size_t level = 0; levelData[level].numBins > 1; ++level)
+                levelData.push_back (levelData[level].halved());
+        }
+
+        if (failed.load (std::memory_order_relaxed))
+            py::pybind11_fail ("Unable to read the source file");
+
+        write (sidecarFile, key, sampleRate, lengthInSamples, numChannels, samplesPerBin, levelData);
+    }
+
+private:
+    AudioPeakPyramid() = default;
+
+    static constexpr const char* fileMagic = "PKPY";
+    static constexpr int fileVersion = 1;
+
+    struct SourceKey
+    {
+        int64 size = 0;
+        int64 modificationTime = 0;
+        int64 fingerprint = 0;
+
+        bool operator== (const SourceKey& other) const noexcept
+        {
+            return size == other.size && modificationTime == other.modificationTime && fingerprint == other.fingerprint;
+        }
+
+        static SourceKey create (const File& file)
+        {
+            SourceKey key;
+            key.size = file.getSize();
+            key.modificationTime = file.getLastModificationTime().toMilliseconds();
+
+            FileInputStream stream (file);
+            if (! stream.openedOk())
+                return key;
+
+            // FNV-1a over the head and the tail of the file, where headers and the latest edits usually are
+            constexpr int64 blockSize = 65536;
+            HeapBlock<uint8> block (static_cast<size_t> (blockSize));
+            uint64 hash = 14695981039346656037ull;
+
+            const auto addBlock = [&] (int64 position)
+            {
+                stream.setPosition (position);
+                const auto numRead = stream.read (block.getData(), static_cast<int> (jmin (blockSize, key.size - position)));
+
+                for (int index = 0; index < numRead; ++index)
+                    hash = (hash ^ block[index]) * 1099511628211ull;
+            };
+
+            addBlock (0);
+            if (key.size > blockSize)
+                addBlock (jmax (blockSize, key.size - blockSize));
+
+            key.fingerprint = static_cast<int64> (hash);
+            return key;
+        }
+
+        static SourceKey read (InputStream& stream)
+        {
+            SourceKey key;
+            key.size = stream.readInt64();
+            key.modificationTime = stream.readInt64();
+            key.fingerprint = stream.readInt64();
+            return key;
+        }
+
+        void write (OutputStream& stream) const
+        {
+            stream.writeInt64 (size);
+            stream.writeInt64 (modificationTime);
+            stream.writeInt64 (fingerprint);
+        }
+    };
+
+    struct LevelData
+    {
+        void allocate (int64 numBinsToAllocate, int numChannelsToAllocate)
+        {
+            numBins = numBinsToAllocate;
+            numChannels = numChannelsToAllocate;
+
+            const auto numValues = static_cast<size_t> (numBins) * static_cast<size_t> (numChannels);
+            minimums.assign (numValues, 0.0f);
+            maximums.assign (numValues, 0.0f);
+            sumSquares.assign (numValues, 0.0);
+        }
+
+        void summarise (int64 bin, int channel, const float* samples, int numSamples) noexcept
+        {
+            if (numSamples <= 0)
+                return;
+
+            const auto index = static_cast<size_t> (bin * numChannels + channel);
+            const auto range = FloatVectorOperations::findMinAndMax (samples, numSamples);
+
+            double sum = 0.0;
+            for (int sample = 0; sample < numSamples; ++sample)
+                sum += static_cast<double> (samples[sample]) * static_cast<double> (samples[sample]);
+
+            minimums[index] = range.getStart();
+            maximums[index] = range.getEnd();
+            sumSquares[index] = sum;
+        }
+
+        LevelData halved() const
+        {
+            LevelData result;
+            result.allocate ((numBins + 1) / 2, numChannels);
+
+            for (int64 bin = 0; bin < result.numBins; ++bin)
+            {
+                const auto numSources = jmin<int64> (2, numBins - bin * 2);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    const auto dest = static_cast<size_t> (bin * numChannels + channel);
+                    const auto source = static_cast<size_t> (bin * 2 * numChannels + channel);
+
+                    result.minimums[dest] = minimums[source];
+                    result.maximums[dest] = maximums[source];
+                    result.sumSquares[dest] = sumSquares[source];
+
+                    if (numSources > 1)
+                    {
+                        result.minimums[dest] = jmin (result.minimums[dest], minimums[source + static_cast<size_t> (numChannels)]);
+                        result.maximums[dest] = jmax (result.maximums[dest], maximums[source + static_cast<size_t> (numChannels)]);
+                        result.sumSquares[dest] += sumSquares[source + static_cast<size_t> (numChannels)];
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        int64 numBins = 0;
+        int numChannels = 0;
+        std::vector<float> minimums;
+        std::vector<float> maximums;
+        std::vector<double> sumSquares;
+    };
+
+    static int16 quantise (double value) noexcept
+    {
+        return static_cast<int16> (ByteOrder::swapIfBigEndian (static_cast<uint16> (static_cast<int16> (roundToInt (jlimit (-1.0, 1.0, value) * 32767.0)))));
+    }
+
+    static int16 readValue (int16 value) noexcept
+    {
+        return static_cast<int16> (ByteOrder::swapIfBigEndian (static_cast<uint16> (value)));
+    }
+
+    static void write (const File& sidecarFile, const SourceKey& key, double sampleRate, int64 lengthInSamples, int numChannels, int samplesPerBin, const std::vector<LevelData>& levelData)
+    {
+        TemporaryFile temporaryFile (sidecarFile);
+
+        {
+            FileOutputStream stream (temporaryFile.getFile());
+            if (! stream.openedOk())
+                py::pybind11_fail ("Unable to create the peak pyramid sidecar file");
+
+            stream.write (fileMagic, 4);
+            stream.writeInt (fileVersion);
+            key.write (stream);
+            stream.writeDouble (sampleRate);
+            stream.writeInt64 (lengthInSamples);
+            stream.writeInt (numChannels);
+            stream.writeInt (samplesPerBin);
+            stream.writeInt (static_cast<int> (levelData.size()));
+
+            const auto headerSize = stream.getPosition() + static_cast<int64> (levelData.size()) * 16;
+
+            auto dataOffset = headerSize;
+            for (const auto& level : levelData)
+            {
+                stream.writeInt64 (level.numBins);
+                stream.writeInt64 (dataOffset);
+                dataOffset += level.numBins * numChannels * static_cast<int64> (sizeof (AudioPeakRecord));
+            }
+
+            // Records of each bin, rms is stored from the mean of the squares over the samples in the bin
+            for (size_t levelIndex = 0; levelIndex < levelData.size(); ++levelIndex)
+            {
+                const auto& level = levelData[levelIndex];
+                const auto binSize = static_cast<int64> (samplesPerBin) << levelIndex;
+
+                std::vector<AudioPeakRecord> records (level.minimums.size());
+
+                for (int64 bin = 0; bin < level.numBins; ++bin)
+                {
+                    const auto numSamplesInBin = jmax<int64> (1, jmin (binSize, lengthInSamples - bin * binSize));
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        const auto index = static_cast<size_t> (bin * numChannels + channel);
+
+                        records[index].min = quantise (level.minimums[index]);
+                        records[index].max = quantise (level.maximums[index]);
+                        records[index].rms = quantise (std::sqrt (level.sumSquares[index] / static_cast<double> (numSamplesInBin)));
+                    }
+                }
+
+                stream.write (records.data(), records.size() * sizeof (AudioPeakRecord));
+            }
+
+            stream.flush();
+            if (stream.getStatus().failed())
+                py::pybind11_fail ("Unable to write the peak pyramid sidecar file");
+        }
+
+        if (! temporaryFile.overwriteTargetFileWithTemporary())
+            py::pybind11_fail ("Unable to replace the peak pyramid sidecar file");
+    }
+
+    int checkLevel (int level) const
+    {
+        if (! isPositiveAndBelow (level, getNumLevels()))
+            py::pybind11_fail ("Invalid peak pyramid level");
+
+        return level;
+    }
+
+    int64 getLevelSamplesPerBin (int level) const noexcept
+    {
+        return static_cast<int64> (samplesPerBin) << level;
+    }
+
+    const AudioPeakRecord* getLevelData (int level) const noexcept
+    {
+        return reinterpret_cast<const AudioPeakRecord*> (static_cast<const char*> (map->getData()) + levels[static_cast<size_t> (level)].dataOffset);
+    }
+
+    std::shared_ptr<MemoryMappedFile> map;
+    std::vector<Level> levels;
+    double sampleRate = 0.0;
+    int64 lengthInSamples = 0;
+    int numChannels = 0;
+    int samplesPerBin = 0;
+};
+
+std::unique_ptr<AudioPeakPyramid> openOrBuildAudioPeakPyramid (AudioFormatManager& manager, const File& sourceFile, const std::optional<File>& sidecarFile,
+                                                               int samplesPerBin, int numThreads, bool rebuild)
+{
+    const auto sidecar = sidecarFile.value_or (AudioPeakPyramid::getDefaultSidecarFile (sourceFile));
+
+    if (! rebuild)
+    {
+        if (auto pyramid = AudioPeakPyramid::open (sidecar, sourceFile))
+            return pyramid;
+    }
+
+    AudioPeakPyramid::build (manager, sourceFile, sidecar, samplesPerBin, numThreads);
+
+    auto pyramid = AudioPeakPyramid::open (sidecar, sourceFile);
+    if (pyramid == nullptr)
+        py::pybind11_fail ("Unable to open the peak pyramid sidecar file");
+
+    return pyramid;
+}
+
+// ============================================================================================
+
+/**
+ * @brief Writes planar float or integer arrays to a writer, converting integers to left-justified 32 bit samples.
+ */
+template <class T>
+bool writeSamplesToAudioFormatWriter (AudioFormatWriter& writer, const T* const* sourceChannels, int numSourceChannels, int numSamples)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        std::vector<const float*> channels (sourceChannels, sourceChannels + numSourceChannels);
+        channels.push_back (nullptr);
+
+        return writer.writeFromFloatArrays (channels.data(), numSourceChannels, numSamples);
+    }
+    else
+    {
+        constexpr int blockSize = 4096;
+        constexpr int shift = 32 - 8 * static_cast<int> (sizeof (T));
 
-namespace py = pybind11;
-using namespace py::literals;
+        std::vector<int> block (static_cast<size_t> (blockSize) * static_cast<size_t> (numSourceChannels));
+        std::vector<int*> blockChannels (static_cast<size_t> (numSourceChannels) + 1, nullptr);
+
+        for (int channel = 0; channel < numSourceChannels; ++channel)
+            blockChannels[static_cast<size_t> (channel)] = block.data() + static_cast<size_t> (channel) * blockSize;
+
+        for (int offset = 0; offset < numSamples; offset += blockSize)
+        {
+            const auto numToWrite = jmin (blockSize, numSamples - offset);
+
+            for (int channel = 0; channel < numSourceChannels; ++channel)
+            {
+                const auto source = sourceChannels[channel] + offset;
+                const auto dest = blockChannels[static_cast<size_t> (channel)];
+
+                for (int index = 0; index < numToWrite; ++index)
+                    dest[index] = static_cast<int> (static_cast<uint32> (static_cast<int> (source[index])) << shift);
+
+                // Floating point writers expect floats in the same storage
+                if (writer.isFloatingPoint())
+                    FloatVectorOperations::convertFixedToFloat (reinterpret_cast<float*> (dest), dest, 1.0f / 2147483648.0f, numToWrite);
+            }
+
+            if (! writer.write (const_cast<const int**> (blockChannels.data()), numToWrite))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+template <class T>
+bool writeBufferToAudioFormatWriter (AudioFormatWriter& writer, const py::buffer_info& info)
+{
+    int numSamples = 0;
+    const auto channels = getBufferChannelPointers<const T> (info, numSamples);
+
+    if (static_cast<int> (channels.size()) != writer.getNumChannels())
+        py::pybind11_fail ("Buffer must have the same number of channels as the writer");
+
+    py::gil_scoped_release release;
+    return writeSamplesToAudioFormatWriter (writer, channels.data(), static_cast<int> (channels.size()), numSamples);
+}
+
+bool writeArraysToAudioFormatWriter (AudioFormatWriter& writer, py::buffer source)
+{
+    const auto info = source.request();
+
+    if (isBufferOfType<float> (info))
+        return writeBufferToAudioFormatWriter<float> (writer, info);
+
+    if (isBufferOfType<int> (info))
+        return writeBufferToAudioFormatWriter<int> (writer, info);
+
+    if (isBufferOfType<int16> (info))
+        return writeBufferToAudioFormatWriter<int16> (writer, info);
+
+    py::pybind11_fail ("Buffer must hold float32, int32 or int16 samples");
+}
+
+// ============================================================================================
+
+/**
+ * @brief Forwards everything to a writer owned elsewhere, so a ThreadedWriter can own this instead of a python writer.
+ */
+struct ForwardingAudioFormatWriter : AudioFormatWriter
+{
+    explicit ForwardingAudioFormatWriter (AudioFormatWriter& writerToUse)
+        : AudioFormatWriter (nullptr, writerToUse.getFormatName(), writerToUse.getSampleRate(),
+                             static_cast<unsigned int> (writerToUse.getNumChannels()), static_cast<unsigned int> (writerToUse.getBitsPerSample()))
+        , writer (writerToUse)
+    {
+        usesFloatingPointData = writer.isFloatingPoint();
+    }
+
+    bool write (const int** samplesToWrite, int numSamples) override
+    {
+        return writer.write (samplesToWrite, numSamples);
+    }
+
+    bool flush() override
+    {
+        return writer.flush();
+    }
+
+    AudioFormatWriter& writer;
+};
+
+/**
+ * @brief Queues blocks from any thread into the FIFO of a ThreadedWriter, encoding them to disk on a TimeSliceThread.
+ *
+ * Writing never waits for the disk: when the FIFO is full the block is dropped and counted instead.
+ */
+class ThreadedAudioFormatWriter
+{
+public:
+    ThreadedAudioFormatWriter (AudioFormatWriter& writer, TimeSliceThread* threadToUse, int numSamplesToBuffer)
+        : numChannels (writer.getNumChannels())
+    {
+        if (numSamplesToBuffer <= 0)
+            py::pybind11_fail ("Number of samples to buffer must be greater than zero");
+
+        if (threadToUse == nullptr)
+        {
+            ownedThread = std::make_unique<TimeSliceThread> ("ThreadedAudioFormatWriter");
+            threadToUse = ownedThread.get();
+        }
+
+        if (! threadToUse->isThreadRunning())
+            threadToUse->startThread();
+
+        threadedWriter = std::make_unique<AudioFormatWriter::ThreadedWriter> (new ForwardingAudioFormatWriter (writer), *threadToUse, numSamplesToBuffer);
+    }
+
+    ~ThreadedAudioFormatWriter()
+    {
+        // Pending samples are flushed through the writer and the data receiver, which might need the GIL
+        if (PyGILState_Check())
+        {
+            py::gil_scoped_release release;
+            close();
+        }
+        else
+        {
+            close();
+        }
+    }
+
+    bool write (const float* const* data, int numSamples)
+    {
+        if (threadedWriter == nullptr || ! threadedWriter->write (data, numSamples))
+        {
+            numSamplesDropped.fetch_add (numSamples, std::memory_order_relaxed);
+            return false;
+        }
+
+        numSamplesQueued.fetch_add (numSamples, std::memory_order_relaxed);
+        return true;
+    }
+
+    void close()
+    {
+        threadedWriter.reset();
+
+        if (ownedThread != nullptr)
+            ownedThread->stopThread (-1);
+    }
+
+    void setDataReceiver (AudioFormatWriter::ThreadedWriter::IncomingDataReceiver* receiver)
+    {
+        if (threadedWriter != nullptr)
+            threadedWriter->setDataReceiver (receiver);
+    }
+
+    void setFlushInterval (int numSamplesPerFlush) noexcept
+    {
+        if (threadedWriter != nullptr)
+            threadedWriter->setFlushInterval (numSamplesPerFlush);
+    }
+
+    int getNumChannels() const noexcept { return numChannels; }
+    bool isOpen() const noexcept { return threadedWriter != nullptr; }
+    int64 getNumSamplesQueued() const noexcept { return numSamplesQueued.load (std::memory_order_relaxed); }
+    int64 getNumSamplesDropped() const noexcept { return numSamplesDropped.load (std::memory_order_relaxed); }
+
+private:
+    const int numChannels;
+    std::unique_ptr<TimeSliceThread> ownedThread;
+    std::unique_ptr<AudioFormatWriter::ThreadedWriter> threadedWriter;
+    std::atomic<int64> numSamplesQueued { 0 };
+    std::atomic<int64> numSamplesDropped { 0 };
+};
+
+// ============================================================================================
+
+/**
+ * @brief Iterates a reader in fixed size blocks, decoding the next blocks on a TimeSliceThread while python consumes.
+ *
+ * A ring of numBlocksAhead + 1 AudioBuffer is reused for the whole iteration: the block handed to python stays untouched
+ * until the following one is requested, while the others are filled in the background. Waiting for a block that isn't
+ * decoded yet is counted as a stall.
+ */
+class AudioFormatReaderBlockIterator : private TimeSliceClient
+{
+public:
+    AudioFormatReaderBlockIterator (AudioFormatReader& readerToUse, int blockSizeToUse, int numBlocksAheadToUse,
+                                    int64 startSample, int64 numSamples, TimeSliceThread* threadToUse)
+        : reader (readerToUse)
+        , blockSize (blockSizeToUse)
+        , numBlocksAhead (numBlocksAheadToUse)
+    {
+        if (blockSize <= 0)
+            py::pybind11_fail ("Block size must be greater than zero");
+
+        if (numBlocksAhead <= 0)
+            py::pybind11_fail ("Number of blocks ahead must be greater than zero");
+
+        if (startSample < 0 || startSample > reader.lengthInSamples)
+            py::pybind11_fail ("Start sample is outside of the reader length");
+
+        firstSample = startSample;
+        endSample = numSamples < 0 ? reader.lengthInSamples : jmin (reader.lengthInSamples, startSample + numSamples);
+        numBlocks = (endSample - firstSample + blockSize - 1) / blockSize;
+
+        slots.resize (static_cast<size_t> (numBlocksAhead + 1));
+        for (auto& slot : slots)
+            slot.setSize (static_cast<int> (reader.numChannels), blockSize);
+
+        if (threadToUse == nullptr)
+        {
+            ownedThread = std::make_unique<TimeSliceThread> ("AudioFormatReaderBlockIterator");
+            threadToUse = ownedThread.get();
+        }
+
+        thread = threadToUse;
+        thread->addTimeSliceClient (this);
+
+        if (! thread->isThreadRunning())
+            thread->startThread();
+    }
+
+    ~AudioFormatReaderBlockIterator() override
+    {
+        // The thread might be waiting for the GIL to decode from a python reader
+        if (PyGILState_Check())
+        {
+            py::gil_scoped_release release;
+            stop();
+        }
+        else
+        {
+            stop();
+        }
+    }
+
+    AudioBuffer<float>* next()
+    {
+        if (thread == nullptr)
+            return nullptr;
+
+        // Hand back the previous block, so it can be refilled
+        if (numConsumed > numReleased.load (std::memory_order_relaxed))
+        {
+            numReleased.fetch_add (1, std::memory_order_release);
+            thread->moveToFrontOfQueue (this);
+        }
+
+        if (numConsumed >= numBlocks)
+            return nullptr;
+
+        if (numProduced.load (std::memory_order_acquire) <= numConsumed)
+        {
+            const auto startTime = Time::getMillisecondCounterHiRes();
+
+            while (numProduced.load (std::memory_order_acquire) <= numConsumed)
+            {
+                // A shared thread can be stopped or cleared by its owner, nothing would decode the block anymore
+                const auto isThreadAlive = thread->isThreadRunning() && thread->contains (this);
+
+                if (! isThreadAlive && numProduced.load (std::memory_order_acquire) <= numConsumed)
+                    py::pybind11_fail ("The thread decoding the blocks was stopped before the next block was ready");
+
+                blockReady.wait (100);
+            }
+
+            ++numStalls;
+            stallMilliseconds += Time::getMillisecondCounterHiRes() - startTime;
+        }
+
+        currentBlockStart = firstSample + numConsumed * blockSize;
+        return std::addressof (slots[static_cast<size_t> (numConsumed++ % static_cast<int64> (slots.size()))]);
+    }
+
+    void stop()
+    {
+        if (thread == nullptr)
+            return;
+
+        thread->removeTimeSliceClient (this);
+
+        if (ownedThread != nullptr)
+            ownedThread->stopThread (-1);
+
+        thread = nullptr;
+    }
+
+    int getBlockSize() const noexcept { return blockSize; }
+    int getNumBlocksAhead() const noexcept { return numBlocksAhead; }
+    int64 getNumBlocks() const noexcept { return numBlocks; }
+    int64 getNumBlocksRead() const noexcept { return numConsumed; }
+    int getNumBlocksReady() const noexcept { return static_cast<int> (numProduced.load (std::memory_order_acquire) - numConsumed); }
+    int64 getCurrentBlockStart() const noexcept { return currentBlockStart; }
+    int64 getNumStalls() const noexcept { return numStalls; }
+    double getStallSeconds() const noexcept { return stallMilliseconds / 1000.0; }
+    bool hadReadErrors() const noexcept { return readErrors.load (std::memory_order_relaxed); }
+
+private:
+    int useTimeSlice() override
+    {
+        const auto produced = numProduced.load (std::memory_order_relaxed);
+
+        if (produced >= numBlocks)
+            return -1;
+
+        if (produced - numReleased.load (std::memory_order_acquire) >= static_cast<int64> (slots.size()))
+            return 100;
+
+        auto& slot = slots[static_cast<size_t> (produced % static_cast<int64> (slots.size()))];
+
+        const auto blockStart = firstSample + produced * blockSize;
+        const auto numSamplesInBlock = static_cast<int> (jmin (static_cast<int64> (blockSize), endSample - blockStart));
+        slot.setSize (static_cast<int> (reader.numChannels), numSamplesInBlock, false, false, true);
+
+        bool wasRead = false;
+
+        try
+        {
+            wasRead = reader.read (slot.getArrayOfWritePointers(), slot.getNumChannels(), blockStart, numSamplesInBlock);
+        }
+        catch (const std::exception&)
+        {
+            slot.clear();
+        }
+
+        if (! wasRead)
+            readErrors.store (true, std::memory_order_relaxed);
+
+        numProduced.store (produced + 1, std::memory_order_release);
+        blockReady.signal();
+
+        return 0;
+    }
+
+    AudioFormatReader& reader;
+    const int blockSize;
+    const int numBlocksAhead;
+    int64 firstSample = 0;
+    int64 endSample = 0;
+    int64 numBlocks = 0;
+
+    std::vector<AudioBuffer<float>> slots;
+    std::atomic<int64> numProduced { 0 };
+    std::atomic<int64> numReleased { 0 };
+    WaitableEvent blockReady;
+    std::atomic<bool> readErrors { false };
+
+    int64 numConsumed = 0;
+    int64 currentBlockStart = -1;
+    int64 numStalls = 0;
+    double stallMilliseconds = 0.0;
+
+    std::unique_ptr<TimeSliceThread> ownedThread;
+    TimeSliceThread* thread = nullptr;
+};
+
+// ============================================================================================
+
+/**
+ * @brief Reaches the protected layout of a memory mapped reader, without ever being instantiated.
+ */
+struct MemoryMappedReaderAccess : MemoryMappedAudioFormatReader
+{
+    static int64 getDataChunkStart (const MemoryMappedAudioFormatReader& reader) noexcept
+    {
+        return reader.*(&MemoryMappedReaderAccess::dataChunkStart);
+    }
+
+    static int getBytesPerFrame (const MemoryMappedAudioFormatReader& reader) noexcept
+    {
+        return reader.*(&MemoryMappedReaderAccess::bytesPerFrame);
+    }
+
+    static const void* getSamplePointer (const MemoryMappedAudioFormatReader& reader, int64 sample) noexcept
+    {
+        return (reader.*(&MemoryMappedReaderAccess::sampleToPointer)) (sample);
+    }
+};
+
+std::atomic<int> mappedMemoryReadSink { 0 };
+
+void touchMappedMemory (const char* data, int64 numBytes) noexcept
+{
+    // Reading one byte every 4KB faults in every page, whatever the actual page size of the system is
+    constexpr int64 touchStride = 4096;
+
+    int sum = 0;
+
+    for (int64 offset = 0; offset < numBytes; offset += touchStride)
+        sum += data[offset];
+
+    if (numBytes > 0)
+        sum += data[numBytes - 1];
+
+    mappedMemoryReadSink.fetch_add (sum, std::memory_order_relaxed);
+}
+
+Range<int64> getMappedSampleRange (int64 startSample, int64 numSamples, Range<int64> availableRange)
+{
+    if (startSample < availableRange.getStart() || startSample > availableRange.getEnd())
+        py::pybind11_fail ("Start sample is outside of the mapped section");
+
+    if (numSamples < 0)
+        numSamples = availableRange.getEnd() - startSample;
+
+    return { startSample, jmin (availableRange.getEnd(), startSample + numSamples) };
+}
+
+MappedSampleFormat getMappedSampleFormat (const MemoryMappedAudioFormatReader& reader, bool eightBitIsSigned)
+{
+    if (reader.usesFloatingPointData)
+    {
+        if (reader.bitsPerSample == 32)
+            return MappedSampleFormat::float32;
+    }
+    else
+    {
+        switch (reader.bitsPerSample)
+        {
+            case 8: return eightBitIsSigned ? MappedSampleFormat::int8 : MappedSampleFormat::uint8;
+            case 16: return MappedSampleFormat::int16;
+            case 24: return MappedSampleFormat::int24Packed;
+            case 32: return MappedSampleFormat::int32;
+            default: break;
+        }
+    }
+
+    py::pybind11_fail ("Memory mapped reader holds samples in a format that can't be viewed directly");
+}
+
+/**
+ * @brief Reads the compression type from the COMM chunk of an AIFF file.
+ *
+ * Plain AIFF files always hold big endian samples and are reported as "NONE", returns an empty string when the file
+ * can't be parsed.
+ */
+String getAiffCompressionType (const File& file)
+{
+    FileInputStream input (file);
+    if (! input.openedOk())
+        return {};
+
+    const auto readChunkName = [&input]
+    {
+        char name[4] = {};
+        return input.read (name, 4) == 4 ? String (name, 4) : String();
+    };
+
+    if (readChunkName() != "FORM")
+        return {};
+
+    input.readIntBigEndian();
+
+    const auto formType = readChunkName();
+    if (formType != "AIFF" && formType != "AIFC")
+        return {};
+
+    while (! input.isExhausted())
+    {
+        const auto chunkName = readChunkName();
+        const auto chunkSize = static_cast<uint32> (input.readIntBigEndian());
+        const auto chunkEnd = input.getPosition() + static_cast<int64> (chunkSize) + static_cast<int64> (chunkSize & 1);
+
+        if (chunkName == "COMM")
+        {
+            if (formType == "AIFF")
+                return "NONE";
+
+            // Skip the channels, frames, bits per sample and the 80 bit sample rate
+            input.skipNextBytes (18);
+            return readChunkName();
+        }
+
+        if (chunkName.isEmpty() || ! input.setPosition (chunkEnd))
+            break;
+    }
+
+    return {};
+}
+
+MappedAudioSampleView createMappedAudioSampleView (const MemoryMappedAudioFormatReader& reader, int64 startSample, int64 numSamples)
+{
+    const auto range = getMappedSampleRange (startSample, numSamples, { 0, reader.lengthInSamples });
+
+    MappedAudioSampleView view;
+    view.startSample = range.getStart();
+    view.numSamples = range.getLength();
+    view.numChannels = static_cast<int> (reader.numChannels);
+    view.bytesPerSample = static_cast<int> (reader.bitsPerSample) / 8;
+    view.bytesPerFrame = MemoryMappedReaderAccess::getBytesPerFrame (reader);
+
+    if (reader.bitsPerSample % 8 != 0 || view.bytesPerFrame != view.numChannels * view.bytesPerSample)
+        py::pybind11_fail ("Memory mapped reader doesn't hold plain interleaved PCM samples");
+
+    const auto formatName = reader.getFormatName();
+
+    if (formatName.containsIgnoreCase ("AIFF"))
+    {
+        // AIFF-C files declare little endian samples with the 'sowt' compression type
+        const auto compressionType = getAiffCompressionType (reader.getFile());
+
+        if (compressionType == "sowt")
+            view.littleEndian = true;
+        else if (StringArray { "NONE", "twos", "raw ", "in24", "in32", "fl32", "FL32" }.contains (compressionType))
+            view.littleEndian = false;
+        else
+            py::pybind11_fail ("Unable to determine the byte order of the AIFF samples");
+
+        view.sampleFormat = getMappedSampleFormat (reader, compressionType != "raw ");
+    }
+    else if (formatName.containsIgnoreCase ("WAV"))
+    {
+        view.littleEndian = true;
+        view.sampleFormat = getMappedSampleFormat (reader, false);
+    }
+    else
+    {
+        py::pybind11_fail ("Unable to determine the byte order of the mapped samples");
+    }
+
+    if (view.numSamples > 0)
+    {
+        const auto fileStart = MemoryMappedReaderAccess::getDataChunkStart (reader) + view.startSample * view.bytesPerFrame;
+        const auto fileRange = Range<int64> (fileStart, fileStart + view.numSamples * view.bytesPerFrame);
+
+        view.map = std::make_unique<MemoryMappedFile> (reader.getFile(), fileRange, MemoryMappedFile::readOnly, false);
+
+        if (view.map->getData() == nullptr || ! view.map->getRange().contains (fileRange))
+            py::pybind11_fail ("Unable to map the requested section of the audio file");
+
+        view.data = static_cast<const char*> (view.map->getData()) + (fileStart - view.map->getRange().getStart());
+    }
+
+    return view;
+}
+
+const char* getMappedSampleFormatDescriptor (const MappedAudioSampleView& view) noexcept
+{
+    switch (view.sampleFormat)
+    {
+        case MappedSampleFormat::uint8: return "B";
+        case MappedSampleFormat::int8: return "b";
+        case MappedSampleFormat::int16: return view.littleEndian ? "<h" : ">h";
+        case MappedSampleFormat::int24Packed: return "B";
+        case MappedSampleFormat::int32: return view.littleEndian ? "<i" : ">i";
+        case MappedSampleFormat::float32: return view.littleEndian ? "<f" : ">f";
+    }
+
+    return "B";
+}
+
+template <class T>
+void registerAudioSampleArray (py::module_& m, const char* name)
+{
+    py::class_<AudioSampleArray<T>> (m, name, py::buffer_protocol())
+        .def (py::init<int, int>(), "numChannels"_a, "numSamples"_a)
+        .def ("getNumChannels", [](const AudioSampleArray<T>& self) { return self.numChannels; })
+        .def ("getNumSamples", [](const AudioSampleArray<T>& self) { return self.numSamples; })
+        .def ("__len__", [](const AudioSampleArray<T>& self) { return self.numChannels; })
+        .def_buffer ([](AudioSampleArray<T>& self) -> py::buffer_info
+        {
+            constexpr auto itemSize = static_cast<py::ssize_t> (sizeof (T));
+
+            return py::buffer_info (
+                self.data.get(),
+                itemSize,
+                py::format_descriptor<T>::format(),
+                2,
+                { static_cast<py::ssize_t> (self.numChannels), static_cast<py::ssize_t> (self.numSamples) },
+                { static_cast<py::ssize_t> (self.numSamples) * itemSize, itemSize },
+                false);
+        })
+    ;
+}
 
 // ============================================================================================
 
 void registerJuceAudioFormatsBindings (py::module_& m)
 {
+    // ============================================================================================ popsicle::AudioSampleArray
+
+    registerAudioSampleArray<float> (m, "AudioSampleArrayFloat");
+    registerAudioSampleArray<int> (m, "AudioSampleArrayInt32");
+    registerAudioSampleArray<int16> (m, "AudioSampleArrayInt16");
+    registerAudioSampleArray<int8> (m, "AudioSampleArrayInt8");
+
+    // ============================================================================================ popsicle::AudioPeakArray
+
+    py::class_<AudioPeakArray> (m, "AudioPeakArray", py::buffer_protocol())
+        .def (py::init<int, int, int>(), "numChannels"_a, "numColumns"_a, "numFields"_a)
+        .def ("getNumChannels", [](const AudioPeakArray& self) { return self.numChannels; })
+        .def ("getNumColumns", [](const AudioPeakArray& self) { return self.numColumns; })
+        .def ("getNumFields", [](const AudioPeakArray& self) { return self.numFields; })
+        .def ("__len__", [](const AudioPeakArray& self) { return self.numChannels; })
+        .def_buffer ([](AudioPeakArray& self) -> py::buffer_info
+        {
+            constexpr auto itemSize = static_cast<py::ssize_t> (sizeof (float));
+            const auto numColumns = static_cast<py::ssize_t> (self.numColumns);
+            const auto numFields = static_cast<py::ssize_t> (self.numFields);
+
+            return py::buffer_info (
+                self.data.get(),
+                itemSize,
+                py::format_descriptor<float>::format(),
+                3,
+                { static_cast<py::ssize_t> (self.numChannels), numColumns, numFields },
+                { numColumns * numFields * itemSize, numFields * itemSize, itemSize },
+                false);
+        })
+    ;
+
     // ============================================================================================ juce::AudioFormatReader
 
     py::class_<AudioFormatReader, PyAudioFormatReader<>> classAudioFormatReader (m, "AudioFormatReader");
@@ -40,6 +1970,7 @@ void registerJuceAudioFormatsBindings (py::module_& m)
     //.def ("read", py::overload_cast<int* const*, int, juce::int64, int, bool> (&AudioFormatReader::read))
         .def ("read", py::overload_cast<AudioBuffer<float>*, int, int, juce::int64, bool, bool> (&AudioFormatReader::read))
         .def ("readMaxLevels", py::overload_cast<juce::int64, juce::int64, Range<float>*, int> (&AudioFormatReader::readMaxLevels))
+        .def ("readMaxLevelsBatch", &readMaxLevelsBatch, "startSample"_a, "samplesPerColumn"_a, "numColumns"_a)
     //.def ("readMaxLevels", py::overload_cast<juce::int64, juce::int64, float&, float&, float&, float&> (&AudioFormatReader::readMaxLevels))
         .def ("searchForLevel", &AudioFormatReader::searchForLevel)
         .def_readwrite ("sampleRate", &AudioFormatReader::sampleRate)
@@ -51,6 +1982,63 @@ void registerJuceAudioFormatsBindings (py::module_& m)
         .def_readwrite ("input", &AudioFormatReader::input)
         .def ("getChannelLayout", &AudioFormatReader::getChannelLayout)
     //.def ("readSamples", &AudioFormatReader::readSamples)
+        .def ("readInto", &readAudioFormatReaderInto, "dest"_a, "startSampleInFile"_a = 0)
+        .def ("iterateBlocks", [](AudioFormatReader& self, int blockSize, int numBlocksAhead, int64 startSample, int64 numSamples, TimeSliceThread* thread)
+        {
+            return std::make_unique<AudioFormatReaderBlockIterator> (self, blockSize, numBlocksAhead, startSample, numSamples, thread);
+        }, "blockSize"_a, "numBlocksAhead"_a = 4, "startSample"_a = 0, "numSamples"_a = -1, "thread"_a = static_cast<TimeSliceThread*> (nullptr),
+            py::keep_alive<0, 1>(), py::keep_alive<0, 6>())
+        .def ("readAll", [](AudioFormatReader& self, int64 startSampleInFile, int64 numSamples, bool asFloat)
+        {
+            const auto numSamplesToRead = getAudioFormatReaderNumSamples (self, startSampleInFile, numSamples);
+
+            if (asFloat || self.usesFloatingPointData)
+                return readAllFromAudioFormatReader<float> (self, startSampleInFile, numSamplesToRead);
+
+            if (self.bitsPerSample <= 8)
+                return readAllFromAudioFormatReader<int8> (self, startSampleInFile, numSamplesToRead);
+
+            if (self.bitsPerSample <= 16)
+                return readAllFromAudioFormatReader<int16> (self, startSampleInFile, numSamplesToRead);
+
+            return readAllFromAudioFormatReader<int> (self, startSampleInFile, numSamplesToRead);
+        }, "startSampleInFile"_a = 0, "numSamples"_a = -1, "asFloat"_a = true)
+    ;
+
+    // ============================================================================================ popsicle::AudioFormatReaderBlockIterator
+
+    py::class_<AudioFormatReaderBlockIterator> classAudioFormatReaderBlockIterator (m, "AudioFormatReaderBlockIterator");
+
+    classAudioFormatReaderBlockIterator
+        .def (py::init<AudioFormatReader&, int, int, int64, int64, TimeSliceThread*>(),
+            "reader"_a, "blockSize"_a, "numBlocksAhead"_a = 4, "startSample"_a = 0, "numSamples"_a = -1, "thread"_a = static_cast<TimeSliceThread*> (nullptr),
+            py::keep_alive<1, 2>(), py::keep_alive<1, 7>())
+        .def ("__iter__", [](AudioFormatReaderBlockIterator& self) { return std::addressof (self); }, py::return_value_policy::reference)
+        .def ("__next__", [](AudioFormatReaderBlockIterator& self)
+        {
+            AudioBuffer<float>* block = nullptr;
+
+            {
+                py::gil_scoped_release release;
+                block = self.next();
+            }
+
+            if (block == nullptr)
+                throw py::stop_iteration();
+
+            return block;
+        }, py::return_value_policy::reference_internal)
+        .def ("close", &AudioFormatReaderBlockIterator::stop, py::call_guard<py::gil_scoped_release>())
+        .def ("getBlockSize", &AudioFormatReaderBlockIterator::getBlockSize)
+        .def ("getNumBlocksAhead", &AudioFormatReaderBlockIterator::getNumBlocksAhead)
+        .def ("getNumBlocks", &AudioFormatReaderBlockIterator::getNumBlocks)
+        .def ("getNumBlocksRead", &AudioFormatReaderBlockIterator::getNumBlocksRead)
+        .def ("getNumBlocksReady", &AudioFormatReaderBlockIterator::getNumBlocksReady)
+        .def ("getCurrentBlockStart", &AudioFormatReaderBlockIterator::getCurrentBlockStart)
+        .def ("getNumStalls", &AudioFormatReaderBlockIterator::getNumStalls)
+        .def ("getStallSeconds", &AudioFormatReaderBlockIterator::getStallSeconds)
+        .def ("hadReadErrors", &AudioFormatReaderBlockIterator::hadReadErrors)
+        .def ("__len__", [](const AudioFormatReaderBlockIterator& self) { return self.getNumBlocks(); })
     ;
 
     // ============================================================================================ juce::AudioSubsectionReader
@@ -72,6 +2060,51 @@ void registerJuceAudioFormatsBindings (py::module_& m)
         .def ("setReadTimeout", &BufferingAudioReader::setReadTimeout)
     ;
 
+    // ============================================================================================ popsicle::MappedAudioSampleView
+
+    py::class_<MappedAudioSampleView> classMappedAudioSampleView (m, "MappedAudioSampleView", py::buffer_protocol());
+
+    py::enum_<MappedSampleFormat> (classMappedAudioSampleView, "SampleFormat")
+        .value ("uint8", MappedSampleFormat::uint8)
+        .value ("int8", MappedSampleFormat::int8)
+        .value ("int16", MappedSampleFormat::int16)
+        .value ("int24Packed", MappedSampleFormat::int24Packed)
+        .value ("int32", MappedSampleFormat::int32)
+        .value ("float32", MappedSampleFormat::float32)
+        .export_values();
+
+    classMappedAudioSampleView
+        .def ("getStartSample", [](const MappedAudioSampleView& self) { return self.startSample; })
+        .def ("getNumSamples", [](const MappedAudioSampleView& self) { return self.numSamples; })
+        .def ("getNumChannels", [](const MappedAudioSampleView& self) { return self.numChannels; })
+        .def ("getSampleFormat", [](const MappedAudioSampleView& self) { return self.sampleFormat; })
+        .def ("isLittleEndian", [](const MappedAudioSampleView& self) { return self.littleEndian; })
+        .def ("isPacked24", [](const MappedAudioSampleView& self) { return self.sampleFormat == MappedSampleFormat::int24Packed; })
+        .def ("touch", [](const MappedAudioSampleView& self, int64 startSample, int64 numSamples)
+        {
+            const auto range = getMappedSampleRange (startSample, numSamples, { 0, self.numSamples });
+            if (range.isEmpty())
+                return;
+
+            py::gil_scoped_release release;
+            touchMappedMemory (self.data + range.getStart() * self.bytesPerFrame, range.getLength() * self.bytesPerFrame);
+        }, "startSample"_a = 0, "numSamples"_a = -1)
+        .def ("__len__", [](const MappedAudioSampleView& self) { return self.numChannels; })
+        .def_buffer ([](MappedAudioSampleView& self) -> py::buffer_info
+        {
+            auto data = const_cast<char*> (self.data);
+            const auto numChannels = static_cast<py::ssize_t> (self.numChannels);
+            const auto numSamples = static_cast<py::ssize_t> (self.numSamples);
+            const auto bytesPerSample = static_cast<py::ssize_t> (self.bytesPerSample);
+            const auto bytesPerFrame = static_cast<py::ssize_t> (self.bytesPerFrame);
+
+            if (self.sampleFormat == MappedSampleFormat::int24Packed)
+                return py::buffer_info (data, 1, "B", 3, { numChannels, numSamples, bytesPerSample }, { bytesPerSample, bytesPerFrame, py::ssize_t (1) }, true);
+
+            return py::buffer_info (data, bytesPerSample, getMappedSampleFormatDescriptor (self), 2, { numChannels, numSamples }, { bytesPerSample, bytesPerFrame }, true);
+        })
+    ;
+
     // ============================================================================================ juce::MemoryMappedAudioFormatReader
 
     py::class_<MemoryMappedAudioFormatReader, AudioFormatReader, PyMemoryMappedAudioFormatReader<>> classMemoryMappedAudioFormatReader (m, "MemoryMappedAudioFormatReader");
@@ -84,7 +2117,27 @@ void registerJuceAudioFormatsBindings (py::module_& m)
         .def ("mapSectionOfFile", &MemoryMappedAudioFormatReader::mapSectionOfFile)
         .def ("getMappedSection", &MemoryMappedAudioFormatReader::getMappedSection)
         .def ("touchSample", &MemoryMappedAudioFormatReader::touchSample)
-        .def ("touchSample", &MemoryMappedAudioFormatReader::touchSample)
+        .def ("touchSamples", [](const MemoryMappedAudioFormatReader& self, int64 startSample, int64 numSamples)
+        {
+            const auto range = getMappedSampleRange (startSample, numSamples, self.getMappedSection());
+            if (range.isEmpty())
+                return;
+
+            const auto data = static_cast<const char*> (MemoryMappedReaderAccess::getSamplePointer (self, range.getStart()));
+            const auto numBytes = range.getLength() * MemoryMappedReaderAccess::getBytesPerFrame (self);
+
+            py::gil_scoped_release release;
+            touchMappedMemory (data, numBytes);
+        }, "startSample"_a, "numSamples"_a = -1)
+        .def ("createSampleView", &createMappedAudioSampleView, "startSample"_a = 0, "numSamples"_a = -1)
+        .def ("getMappedSampleView", [](const MemoryMappedAudioFormatReader& self)
+        {
+            const auto section = self.getMappedSection();
+            if (section.isEmpty())
+                py::pybind11_fail ("Memory mapped reader has no mapped section");
+
+            return createMappedAudioSampleView (self, section.getStart(), section.getLength());
+        })
     //.def ("getSample", &MemoryMappedAudioFormatReader::getSample)
         .def ("getNumBytesUsed", &MemoryMappedAudioFormatReader::getNumBytesUsed)
     ;
@@ -110,6 +2163,7 @@ void registerJuceAudioFormatsBindings (py::module_& m)
             "destStream"_a, "formatName"_a, "sampleRate"_a, "audioChannelLayout"_a, "bitsPerSample"_a)
         .def ("getFormatName", &AudioFormatWriter::getFormatName)
     //.def ("write", &AudioFormatWriter::write)
+        .def ("writeFromArrays", &writeArraysToAudioFormatWriter, "source"_a)
         .def ("flush", &AudioFormatWriter::flush)
         .def ("writeFromAudioReader", &AudioFormatWriter::writeFromAudioReader, "reader"_a, "startSample"_a, "numSamplesToRead"_a)
         .def ("writeFromAudioSource", &AudioFormatWriter::writeFromAudioSource, "source"_a, "numSamplesToRead"_a, "samplesPerBlock"_a = 2048)
@@ -122,6 +2176,39 @@ void registerJuceAudioFormatsBindings (py::module_& m)
         .def ("writeFromAudioSampleBuffer", &AudioFormatWriter::writeFromAudioSampleBuffer)
     ;
 
+    py::class_<ThreadedAudioFormatWriter> classThreadedWriter (classAudioFormatWriter, "ThreadedWriter");
+
+    py::class_<AudioFormatWriter::ThreadedWriter::IncomingDataReceiver, PyAudioFormatWriterIncomingDataReceiver> (classThreadedWriter, "IncomingDataReceiver")
+        .def (py::init<>())
+        .def ("reset", &AudioFormatWriter::ThreadedWriter::IncomingDataReceiver::reset)
+        .def ("addBlock", &AudioFormatWriter::ThreadedWriter::IncomingDataReceiver::addBlock)
+    ;
+
+    classThreadedWriter
+        .def (py::init<AudioFormatWriter&, TimeSliceThread*, int>(),
+            "writer"_a, "backgroundThread"_a = static_cast<TimeSliceThread*> (nullptr), "numSamplesToBuffer"_a = 65536,
+            py::keep_alive<1, 2>(), py::keep_alive<1, 3>())
+        .def ("write", [](ThreadedAudioFormatWriter& self, py::buffer data)
+        {
+            const auto info = data.request();
+
+            int numSamples = 0;
+            const auto channels = getBufferChannelPointers<const float> (info, numSamples);
+
+            if (static_cast<int> (channels.size()) != self.getNumChannels())
+                py::pybind11_fail ("Buffer must have the same number of channels as the writer");
+
+            return self.write (channels.data(), numSamples);
+        }, "data"_a)
+        .def ("close", &ThreadedAudioFormatWriter::close, py::call_guard<py::gil_scoped_release>())
+        .def ("isOpen", &ThreadedAudioFormatWriter::isOpen)
+        .def ("setDataReceiver", &ThreadedAudioFormatWriter::setDataReceiver, py::keep_alive<1, 2>(), py::call_guard<py::gil_scoped_release>())
+        .def ("setFlushInterval", &ThreadedAudioFormatWriter::setFlushInterval)
+        .def ("getNumChannels", &ThreadedAudioFormatWriter::getNumChannels)
+        .def ("getNumSamplesQueued", &ThreadedAudioFormatWriter::getNumSamplesQueued)
+        .def ("getNumSamplesDropped", &ThreadedAudioFormatWriter::getNumSamplesDropped)
+    ;
+
     // ============================================================================================ juce::AudioFormat
 
     py::class_<AudioFormat, PyAudioFormat<>> classAudioFormat (m, "AudioFormat");
@@ -144,6 +2231,22 @@ void registerJuceAudioFormatsBindings (py::module_& m)
         .def ("createMemoryMappedReader", py::overload_cast<FileInputStream*> (&AudioFormat::createMemoryMappedReader))
         .def ("createWriterFor", py::overload_cast<OutputStream*, double, unsigned int, int, const StringPairArray&, int> (&AudioFormat::createWriterFor))
         .def ("createWriterFor", py::overload_cast<OutputStream*, double, const AudioChannelSet&, int, const StringPairArray&, int> (&AudioFormat::createWriterFor))
+        .def ("createWriterFor", [](AudioFormat& self, const File& file, double sampleRateToUse, unsigned int numberOfChannels, int bitsPerSample, const StringPairArray& metadataValues, int qualityOptionIndex) -> AudioFormatWriter*
+        {
+            std::unique_ptr<FileOutputStream> stream (file.createOutputStream());
+            if (stream == nullptr)
+                return nullptr;
+
+            // Output streams append to existing files
+            stream->setPosition (0);
+            stream->truncate();
+
+            auto writer = self.createWriterFor (stream.get(), sampleRateToUse, numberOfChannels, bitsPerSample, metadataValues, qualityOptionIndex);
+            if (writer != nullptr)
+                stream.release();
+
+            return writer;
+        }, "file"_a, "sampleRateToUse"_a, "numberOfChannels"_a, "bitsPerSample"_a, "metadataValues"_a = StringPairArray(), "qualityOptionIndex"_a = 0)
     ;
 
     // ============================================================================================ juce::WavAudioFormat
@@ -281,6 +2384,37 @@ void registerJuceAudioFormatsBindings (py::module_& m)
 
     // ============================================================================================ juce::AudioFormatManager
 
+    py::class_<AudioFileDecodeResult> classAudioFileDecodeResult (m, "AudioFileDecodeResult");
+
+    classAudioFileDecodeResult
+        .def ("wasSuccessful", [](const AudioFileDecodeResult& self) { return self.info.error.isEmpty(); })
+        .def_readonly ("samples", &AudioFileDecodeResult::samples)
+        .def_property_readonly ("error", [](const AudioFileDecodeResult& self) { return self.info.error; })
+        .def_property_readonly ("sourceSampleRate", [](const AudioFileDecodeResult& self) { return self.info.sourceSampleRate; })
+        .def_property_readonly ("numSourceChannels", [](const AudioFileDecodeResult& self) { return self.info.numSourceChannels; })
+        .def_property_readonly ("lengthInSamples", [](const AudioFileDecodeResult& self) { return self.info.lengthInSamples; })
+        .def_property_readonly ("sampleRate", [](const AudioFileDecodeResult& self) { return self.info.sampleRate; })
+        .def_property_readonly ("numChannels", [](const AudioFileDecodeResult& self) { return self.info.numChannels; })
+        .def_property_readonly ("numSamples", [](const AudioFileDecodeResult& self) { return self.info.numSamples; })
+        .def_property_readonly ("offset", [](const AudioFileDecodeResult& self) { return self.info.offset; })
+        .def ("__bool__", [](const AudioFileDecodeResult& self) { return self.info.error.isEmpty(); })
+        .def ("__repr__", [](const AudioFileDecodeResult& self)
+        {
+            String result;
+            result
+                << Helpers::pythonizeModuleClassName (PythonModuleName, typeid (self).name())
+                << "(";
+
+            if (self.info.error.isNotEmpty())
+                result << "error='" << self.info.error << "'";
+            else
+                result << self.info.numChannels << ", " << self.info.numSamples << ", " << self.info.sampleRate;
+
+            result << ")";
+            return result;
+        })
+    ;
+
     py::class_<AudioFormatManager> classAudioFormatManager (m, "AudioFormatManager");
 
     classAudioFormatManager
@@ -298,8 +2432,116 @@ void registerJuceAudioFormatsBindings (py::module_& m)
         .def ("getDefaultFormat", &AudioFormatManager::getDefaultFormat, py::return_value_policy::reference)
         .def ("getWildcardForAllFormats", &AudioFormatManager::getWildcardForAllFormats)
         .def ("createReaderFor", py::overload_cast<const File&> (&AudioFormatManager::createReaderFor))
+        .def ("decodeFiles", [](AudioFormatManager& self, const py::list& files, int numChannels, int64 startSample, int64 numSamples, double sampleRate, ResamplingQuality quality, int numThreads)
+        {
+            return decodeAudioFiles (self, files, { numChannels, startSample, numSamples, sampleRate, quality }, numThreads);
+        }, "files"_a, "numChannels"_a = -1, "startSample"_a = 0, "numSamples"_a = -1, "sampleRate"_a = 0.0, "quality"_a = ResamplingQuality::windowedSinc, "numThreads"_a = 0)
+        .def ("decodeFilesInto", [](AudioFormatManager& self, const py::list& files, py::buffer dest, int64 startSample, int64 numSamples, double sampleRate, ResamplingQuality quality, int numThreads)
+        {
+            return decodeAudioFilesInto (self, files, dest, { -1, startSample, numSamples, sampleRate, quality }, numThreads);
+        }, "files"_a, "dest"_a, "startSample"_a = 0, "numSamples"_a = -1, "sampleRate"_a = 0.0, "quality"_a = ResamplingQuality::windowedSinc, "numThreads"_a = 0)
     //.def ("createReaderFor", py::overload_cast<std::unique_ptr<InputStream>> (&AudioFormatManager::createReaderFor))
     ;
+
+    // ============================================================================================ popsicle::AudioTranscoder
+
+    py::class_<AudioTranscodeJob> classAudioTranscodeJob (m, "AudioTranscodeJob");
+
+    classAudioTranscodeJob
+        .def (py::init ([](const File& sourceFile, const File& destFile, py::object format, double sampleRate, int numChannels, int bitsPerSample, int qualityOptionIndex, const StringPairArray& metadataValues)
+        {
+            return AudioTranscodeJob { sourceFile, destFile, std::move (format), sampleRate, numChannels, bitsPerSample, qualityOptionIndex, metadataValues };
+        }), "sourceFile"_a, "destFile"_a, "format"_a, "sampleRate"_a = 0.0, "numChannels"_a = -1, "bitsPerSample"_a = 16, "qualityOptionIndex"_a = 0, "metadataValues"_a = StringPairArray())
+        .def_readwrite ("sourceFile", &AudioTranscodeJob::sourceFile)
+        .def_readwrite ("destFile", &AudioTranscodeJob::destFile)
+        .def_readwrite ("format", &AudioTranscodeJob::format)
+        .def_readwrite ("sampleRate", &AudioTranscodeJob::sampleRate)
+        .def_readwrite ("numChannels", &AudioTranscodeJob::numChannels)
+        .def_readwrite ("bitsPerSample", &AudioTranscodeJob::bitsPerSample)
+        .def_readwrite ("qualityOptionIndex", &AudioTranscodeJob::qualityOptionIndex)
+        .def_readwrite ("metadataValues", &AudioTranscodeJob::metadataValues)
+    ;
+
+    py::class_<AudioTranscoder> classAudioTranscoder (m, "AudioTranscoder");
+
+    classAudioTranscoder
+        .def (py::init<AudioFormatManager&, int, int>(), "manager"_a, "numThreads"_a = 0, "blockSize"_a = 8192, py::keep_alive<1, 2>())
+        .def ("start", &AudioTranscoder::start, "jobs"_a, "progressCallback"_a = py::none(), "completionCallback"_a = py::none())
+        .def ("waitForCompletion", &AudioTranscoder::waitForCompletion, "timeoutMilliseconds"_a = -1, py::call_guard<py::gil_scoped_release>())
+        .def ("cancel", &AudioTranscoder::cancel)
+        .def ("isRunning", &AudioTranscoder::isRunning)
+        .def ("getNumJobs", &AudioTranscoder::getNumJobs)
+        .def ("getProgress", &AudioTranscoder::getProgress)
+        .def ("getJobProgress", &AudioTranscoder::getJobProgress)
+        .def ("getErrors", &AudioTranscoder::getErrors)
+        .def_static ("transcode", [](AudioFormatManager& manager, const std::vector<AudioTranscodeJob>& jobs, int numThreads, int blockSize)
+        {
+            AudioTranscoder transcoder (manager, numThreads, blockSize);
+            transcoder.start (jobs, py::none(), py::none());
+
+            {
+                py::gil_scoped_release release;
+                transcoder.waitForCompletion (-1);
+            }
+
+            return transcoder.getErrors();
+        }, "manager"_a, "jobs"_a, "numThreads"_a = 0, "blockSize"_a = 8192)
+    ;
+
+    // ============================================================================================ popsicle::AudioPeakPyramid
+
+    py::class_<AudioPeakLevelView> (m, "AudioPeakLevelView", py::buffer_protocol())
+        .def ("getNumBins", [](const AudioPeakLevelView& self) { return self.numBins; })
+        .def ("getNumChannels", [](const AudioPeakLevelView& self) { return self.numChannels; })
+        .def ("getSamplesPerBin", [](const AudioPeakLevelView& self) { return self.samplesPerBin; })
+        .def ("__len__", [](const AudioPeakLevelView& self) { return self.numBins; })
+        .def_buffer ([](AudioPeakLevelView& self) -> py::buffer_info
+        {
+            constexpr auto itemSize = static_cast<py::ssize_t> (sizeof (AudioPeakRecord));
+
+            return py::buffer_info (
+                const_cast<AudioPeakRecord*> (self.data),
+                itemSize,
+                AudioPeakRecord::format,
+                2,
+                { static_cast<py::ssize_t> (self.numBins), static_cast<py::ssize_t> (self.numChannels) },
+                { static_cast<py::ssize_t> (self.numChannels) * itemSize, itemSize },
+                true);
+        })
+    ;
+
+    py::class_<AudioPeakPyramid> classAudioPeakPyramid (m, "AudioPeakPyramid");
+
+    classAudioPeakPyramid
+        .def_static ("getDefaultSidecarFile", &AudioPeakPyramid::getDefaultSidecarFile, "sourceFile"_a)
+        .def_static ("open", [](const File& sidecarFile, const std::optional<File>& sourceFile)
+        {
+            return AudioPeakPyramid::open (sidecarFile, sourceFile.value_or (File()));
+        }, "sidecarFile"_a, "sourceFile"_a = std::optional<File>())
+        .def_static ("openOrBuild", &openOrBuildAudioPeakPyramid,
+            "manager"_a, "sourceFile"_a, "sidecarFile"_a = std::optional<File>(), "samplesPerBin"_a = 256, "numThreads"_a = 0, "rebuild"_a = false)
+        .def ("getNumChannels", &AudioPeakPyramid::getNumChannels)
+        .def ("getLengthInSamples", &AudioPeakPyramid::getLengthInSamples)
+        .def ("getSampleRate", &AudioPeakPyramid::getSampleRate)
+        .def ("getNumLevels", &AudioPeakPyramid::getNumLevels)
+        .def ("getSamplesPerBin", &AudioPeakPyramid::getSamplesPerBin, "level"_a = 0)
+        .def ("getNumBins", &AudioPeakPyramid::getNumBins, "level"_a)
+        .def ("getLevel", &AudioPeakPyramid::getLevelView, "level"_a)
+        .def ("getPeaks", [](const AudioPeakPyramid& self, int64 startSample, int64 numSamples, int numPixels)
+        {
+            if (numPixels < 0)
+                py::pybind11_fail ("Number of pixels must not be negative");
+
+            AudioPeakArray result (self.getNumChannels(), numPixels, 3);
+
+            {
+                py::gil_scoped_release release;
+                self.getPeaks (startSample, numSamples, result);
+            }
+
+            return result;
+        }, "startSample"_a, "numSamples"_a, "numPixels"_a)
+    ;
 }
 
 } // namespace popsicle::Bindings
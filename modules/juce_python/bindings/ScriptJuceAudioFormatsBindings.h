@@ -292,4 +292,100 @@ struct PyAudioFormat : Base
     }
 };
 
+// =================================================================================================
+
+/**
+ * @brief An owned block of planar samples shaped as (channels, samples), exposed to python through the buffer protocol.
+ *
+ * Samples are left uninitialised on construction, as the array is meant to be filled straight away by a decoder.
+ */
+template <class T>
+struct AudioSampleArray
+{
+    AudioSampleArray (int numChannelsToAllocate, int numSamplesToAllocate)
+        : numChannels (juce::jmax (0, numChannelsToAllocate))
+        , numSamples (juce::jmax (0, numSamplesToAllocate))
+        , data (new T[static_cast<size_t> (numChannels) * static_cast<size_t> (numSamples)])
+    {
+    }
+
+    T* getChannel (int channel) const noexcept
+    {
+        return data.get() + static_cast<size_t> (channel) * static_cast<size_t> (numSamples);
+    }
+
+    std::vector<T*> getChannelPointers() const
+    {
+        std::vector<T*> channels (static_cast<size_t> (numChannels));
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            channels[static_cast<size_t> (channel)] = getChannel (channel);
+
+        return channels;
+    }
+
+    int numChannels = 0;
+    int numSamples = 0;
+    std::unique_ptr<T[]> data;
+};
+
+// =================================================================================================
+
+enum class MappedSampleFormat
+{
+    uint8,
+    int8,
+    int16,
+    int24Packed,
+    int32,
+    float32
+};
+
+/**
+ * @brief A read-only view over the interleaved samples of a memory mapped PCM file, shaped as (channels, samples).
+ *
+ * The view owns its mapping, so it stays valid when the reader that created it remaps another section or is deleted.
+ * Packed 24 bit samples have no matching numpy dtype, so they are exposed as bytes with an extra trailing axis of 3.
+ */
+struct MappedAudioSampleView
+{
+    std::unique_ptr<juce::MemoryMappedFile> map;
+    const char* data = nullptr;
+    juce::int64 startSample = 0;
+    juce::int64 numSamples = 0;
+    int numChannels = 0;
+    int bytesPerSample = 0;
+    int bytesPerFrame = 0;
+    MappedSampleFormat sampleFormat = MappedSampleFormat::int16;
+    bool littleEndian = true;
+};
+
+// =================================================================================================
+
+/**
+ * @brief An owned block of waveform summaries shaped as (channels, columns, fields), exposed through the buffer protocol.
+ *
+ * Values are zero initialised, so columns falling outside of the summarised audio read as silence.
+ */
+struct AudioPeakArray
+{
+    AudioPeakArray (int numChannelsToAllocate, int numColumnsToAllocate, int numFieldsToAllocate)
+        : numChannels (juce::jmax (0, numChannelsToAllocate))
+        , numColumns (juce::jmax (0, numColumnsToAllocate))
+        , numFields (juce::jmax (1, numFieldsToAllocate))
+        , data (new float[static_cast<size_t> (numChannels) * static_cast<size_t> (numColumns) * static_cast<size_t> (numFields)]())
+    {
+    }
+
+    float* getColumn (int channel, int column) const noexcept
+    {
+        return data.get() + (static_cast<size_t> (channel) * static_cast<size_t> (numColumns) + static_cast<size_t> (column)) * static_cast<size_t> (numFields);
+    }
+
+    int numChannels = 0;
+    int numColumns = 0;
+    int numFields = 0;
+    std::unique_ptr<float[]> data;
+};
+
 } // namespace popsicle::Bindings
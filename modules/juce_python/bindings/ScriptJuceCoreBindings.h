@@ -101,6 +101,45 @@ public:
     static handle cast (const juce::var& src, return_value_policy policy, handle parent);
 };
 
+// =================================================================================================
+
+template <class T>
+struct type_caster<juce::Optional<T>>
+{
+    using value_conv = make_caster<T>;
+
+public:
+    PYBIND11_TYPE_CASTER (juce::Optional<T>, const_name ("Optional[") + value_conv::name + const_name ("]"));
+
+    bool load (handle src, bool convert)
+    {
+        if (! src)
+            return false;
+
+        if (src.is_none())
+            return true;
+
+        value_conv innerCaster;
+        if (! innerCaster.load (src, convert))
+            return false;
+
+        value.emplace (cast_op<T&&> (std::move (innerCaster)));
+        return true;
+    }
+
+    template <class U>
+    static handle cast (U&& src, return_value_policy policy, handle parent)
+    {
+        if (! src)
+            return none().release();
+
+        if constexpr (! std::is_lvalue_reference_v<U>)
+            policy = return_value_policy_override<T>::policy (policy);
+
+        return value_conv::cast (*std::forward<U> (src), policy, parent);
+    }
+};
+
 } // namespace detail
 } // namespace PYBIND11_NAMESPACE
 
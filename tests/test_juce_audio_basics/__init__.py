@@ -0,0 +1,8 @@
+import pytest
+
+from .. import common
+
+import popsicle as juce
+
+if not hasattr(juce, "AudioBufferFloat"):
+    pytest.skip(allow_module_level=True)
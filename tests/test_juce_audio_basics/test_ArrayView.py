@@ -0,0 +1,131 @@
+import array
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def make_view(num_samples=16, value=0.0):
+    buffer = juce.AudioBufferFloat(1, num_samples)
+    view = buffer.getWritePointer(0)
+    for index in range(len(view)):
+        view[index] = value
+    return buffer, view
+
+#==================================================================================================
+
+def test_slice_returns_sub_view():
+    buffer, view = make_view(16)
+
+    sub_view = view[4:8]
+    assert isinstance(sub_view, juce.FloatArrayView)
+    assert len(sub_view) == 4
+
+    sub_view[0] = 1.0
+    assert buffer.getSample(0, 4) == pytest.approx(1.0)
+
+    assert len(view[-4:]) == 4
+    assert len(view[10:2]) == 0
+
+    with pytest.raises(RuntimeError):
+        view[::2]
+
+#==================================================================================================
+
+def test_slice_assignment():
+    buffer, view = make_view(8)
+
+    view[2:4] = 0.5
+    assert buffer.getSample(0, 1) == pytest.approx(0.0)
+    assert buffer.getSample(0, 2) == pytest.approx(0.5)
+    assert buffer.getSample(0, 3) == pytest.approx(0.5)
+
+    view[4:8] = array.array("f", [1.0, 2.0, 3.0, 4.0])
+    assert [buffer.getSample(0, i) for i in range(4, 8)] == pytest.approx([1.0, 2.0, 3.0, 4.0])
+
+    view[0:4] = view[4:8]
+    assert [buffer.getSample(0, i) for i in range(0, 4)] == pytest.approx([1.0, 2.0, 3.0, 4.0])
+
+    with pytest.raises(RuntimeError):
+        view[0:2] = array.array("f", [1.0, 2.0, 3.0])
+
+    with pytest.raises(RuntimeError):
+        view[0:2] = array.array("d", [1.0, 2.0])
+
+#==================================================================================================
+
+def test_in_place_scalar_operators():
+    buffer, view = make_view(8, 1.0)
+
+    view += 1.0
+    assert buffer.getSample(0, 0) == pytest.approx(2.0)
+
+    view *= 3.0
+    assert buffer.getSample(0, 7) == pytest.approx(6.0)
+
+    view -= 5.0
+    assert buffer.getSample(0, 3) == pytest.approx(1.0)
+
+#==================================================================================================
+
+def test_in_place_buffer_operators():
+    buffer, view = make_view(4, 1.0)
+    other = array.array("f", [1.0, 2.0, 3.0, 4.0])
+
+    view += other
+    assert [buffer.getSample(0, i) for i in range(4)] == pytest.approx([2.0, 3.0, 4.0, 5.0])
+
+    view *= other
+    assert [buffer.getSample(0, i) for i in range(4)] == pytest.approx([2.0, 6.0, 12.0, 20.0])
+
+    view -= other
+    assert [buffer.getSample(0, i) for i in range(4)] == pytest.approx([1.0, 4.0, 9.0, 16.0])
+
+#==================================================================================================
+
+def test_numpy_scalar_operands():
+    buffer, view = make_view(8, 1.0)
+
+    view += np.float32(1.0)
+    assert buffer.getSample(0, 0) == pytest.approx(2.0)
+
+    view *= np.float32(3.0)
+    assert buffer.getSample(0, 7) == pytest.approx(6.0)
+
+    view -= np.float64(5.0)
+    assert buffer.getSample(0, 3) == pytest.approx(1.0)
+
+    view *= np.array(2.0, dtype=np.float32)
+    assert buffer.getSample(0, 5) == pytest.approx(2.0)
+
+    view[2:4] = np.float32(0.5)
+    assert [buffer.getSample(0, i) for i in range(1, 5)] == pytest.approx([2.0, 0.5, 0.5, 2.0])
+
+    view[0:8] = np.int16(-1)
+    assert [buffer.getSample(0, i) for i in range(8)] == pytest.approx([-1.0] * 8)
+
+#==================================================================================================
+
+def test_fill_clear_clip_negate():
+    buffer, view = make_view(4)
+
+    view.fill(2.0)
+    assert buffer.getMagnitude(0, 0, 4) == pytest.approx(2.0)
+
+    view[0:2].clip(-1.0, 1.0)
+    assert [buffer.getSample(0, i) for i in range(4)] == pytest.approx([1.0, 1.0, 2.0, 2.0])
+
+    view.negate()
+    assert [buffer.getSample(0, i) for i in range(4)] == pytest.approx([-1.0, -1.0, -2.0, -2.0])
+
+    view.clear()
+    assert buffer.getMagnitude(0, 0, 4) == pytest.approx(0.0)
+
+#==================================================================================================
+
+def test_large_span_operations():
+    buffer, view = make_view(16384, 0.25)
+
+    view *= 4.0
+    assert buffer.getMagnitude(0, 0, 16384) == pytest.approx(1.0)
@@ -0,0 +1,259 @@
+import pytest
+import weakref
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def test_buffer_protocol_shape_and_dtype():
+    buffer = juce.AudioBufferFloat(2, 64)
+    array = np.asarray(buffer)
+    assert array.shape == (2, 64)
+    assert array.dtype == np.float32
+
+    buffer = juce.AudioBufferDouble(3, 32)
+    array = np.asarray(buffer)
+    assert array.shape == (3, 32)
+    assert array.dtype == np.float64
+
+#==================================================================================================
+
+def test_buffer_protocol_is_zero_copy():
+    buffer = juce.AudioBufferFloat(2, 16)
+    buffer.clear()
+
+    array = np.asarray(buffer)
+    array[0, :] = 0.5
+    array[1, :] = -0.25
+
+    assert not buffer.hasBeenCleared()
+    assert buffer.getSample(0, 7) == pytest.approx(0.5)
+    assert buffer.getSample(1, 15) == pytest.approx(-0.25)
+
+    buffer.setSample(1, 3, 1.0)
+    assert array[1, 3] == pytest.approx(1.0)
+
+#==================================================================================================
+
+def test_buffer_protocol_whole_buffer_operations():
+    buffer = juce.AudioBufferFloat(4, 128)
+    array = np.asarray(buffer)
+    array[:] = 1.0
+    array *= 0.5
+
+    for channel in range(buffer.getNumChannels()):
+        assert buffer.getMagnitude(channel, 0, buffer.getNumSamples()) == pytest.approx(0.5)
+
+#==================================================================================================
+
+def test_buffer_protocol_memoryview():
+    buffer = juce.AudioBufferFloat(2, 8)
+    view = memoryview(buffer)
+    assert view.ndim == 2
+    assert view.shape == (2, 8)
+    assert view.format == "f"
+    assert not view.readonly
+
+#==================================================================================================
+
+def test_buffer_protocol_empty():
+    buffer = juce.AudioBufferFloat()
+    array = np.asarray(buffer)
+    assert array.shape == (0, 0)
+
+#==================================================================================================
+
+def test_buffer_protocol_exports_lock_layout():
+    buffer = juce.AudioBufferFloat(2, 16)
+    other = juce.AudioBufferFloat(2, 32)
+
+    view = memoryview(buffer)
+    array = np.asarray(buffer)
+
+    with pytest.raises(BufferError):
+        buffer.setSize(4, 64)
+
+    with pytest.raises(BufferError):
+        buffer.makeCopyOf(other)
+
+    with pytest.raises(BufferError):
+        buffer.setDataToReferTo(np.zeros((2, 8), dtype=np.float32))
+
+    assert buffer.getNumChannels() == 2
+    assert buffer.getNumSamples() == 16
+
+    view.release()
+    with pytest.raises(BufferError):
+        buffer.setSize(4, 64)
+
+    del array
+    buffer.setSize(4, 64)
+    assert buffer.getNumChannels() == 4
+    assert buffer.getNumSamples() == 64
+
+    with memoryview(buffer):
+        pass
+
+    buffer.makeCopyOf(other)
+    assert buffer.getNumSamples() == 32
+
+#==================================================================================================
+
+def test_refer_to_contiguous_array():
+    data = np.zeros((2, 32), dtype=np.float32)
+
+    buffer = juce.AudioBufferFloat.referTo(data)
+    assert buffer.getNumChannels() == 2
+    assert buffer.getNumSamples() == 32
+
+    data[1, 5] = 0.75
+    assert buffer.getSample(1, 5) == pytest.approx(0.75)
+
+    buffer.setSample(0, 31, -1.0)
+    assert data[0, 31] == pytest.approx(-1.0)
+
+#==================================================================================================
+
+def test_refer_to_channel_strided_array():
+    data = np.zeros((4, 64), dtype=np.float64)
+    view = data[::2, 8:40]
+
+    buffer = juce.AudioBufferDouble(view)
+    assert buffer.getNumChannels() == 2
+    assert buffer.getNumSamples() == 32
+
+    buffer.applyGain(0.0)
+    buffer.setSample(1, 0, 2.0)
+    assert data[2, 8] == pytest.approx(2.0)
+
+    assert np.asarray(buffer).shape == (2, 32)
+
+#==================================================================================================
+
+def test_refer_to_mono_array():
+    data = np.arange(16, dtype=np.float32)
+
+    buffer = juce.AudioBufferFloat(data, 1, 4, 8)
+    assert buffer.getNumChannels() == 1
+    assert buffer.getNumSamples() == 8
+    assert buffer.getSample(0, 0) == pytest.approx(4.0)
+
+#==================================================================================================
+
+def test_refer_to_keeps_owner_alive():
+    buffer = juce.AudioBufferFloat.referTo(np.full((2, 8), 0.5, dtype=np.float32))
+    assert buffer.getSample(1, 7) == pytest.approx(0.5)
+
+    other = juce.AudioBufferFloat()
+    other.setDataToReferTo(np.full((1, 4), 0.25, dtype=np.float32))
+    assert other.getSample(0, 3) == pytest.approx(0.25)
+
+#==================================================================================================
+
+def test_set_data_to_refer_to_keeps_only_latest_owner():
+    buffer = juce.AudioBufferFloat()
+
+    first = np.full((1, 4), 0.25, dtype=np.float32)
+    first_ref = weakref.ref(first)
+    buffer.setDataToReferTo(first)
+    del first
+    assert first_ref() is not None
+    assert buffer.getSample(0, 3) == pytest.approx(0.25)
+
+    second = np.full((2, 8), 0.5, dtype=np.float32)
+    second_ref = weakref.ref(second)
+    buffer.setDataToReferTo(second, 2, 8)
+    del second
+    assert first_ref() is None
+    assert second_ref() is not None
+    assert buffer.getSample(1, 7) == pytest.approx(0.5)
+
+    del buffer
+    assert second_ref() is None
+
+#==================================================================================================
+
+def test_refer_to_invalid_arrays():
+    with pytest.raises(RuntimeError):
+        juce.AudioBufferFloat.referTo(np.zeros((2, 8), dtype=np.float64))
+
+    with pytest.raises(RuntimeError):
+        juce.AudioBufferFloat.referTo(np.zeros((8, 2), dtype=np.float32).T)
+
+    with pytest.raises(RuntimeError):
+        juce.AudioBufferFloat(np.zeros((2, 8), dtype=np.float32), 3, 0, 8)
+
+    with pytest.raises(RuntimeError):
+        juce.AudioBufferFloat(np.zeros((2, 8), dtype=np.float32), 2, 4, 8)
+
+#==================================================================================================
+
+def test_copy_from_raw_buffer():
+    buffer = juce.AudioBufferFloat(2, 64)
+    buffer.clear()
+
+    source = np.linspace(-1.0, 1.0, 64, dtype=np.float32)
+    buffer.copyFrom(1, 0, source, 64)
+    assert np.array_equal(np.asarray(buffer)[1], source)
+    assert not np.any(np.asarray(buffer)[0])
+
+    buffer.copyFrom(0, 32, source, 16, 0.5)
+    assert np.allclose(np.asarray(buffer)[0, 32:48], source[:16] * 0.5)
+    assert not np.any(np.asarray(buffer)[0, :32])
+
+#==================================================================================================
+
+def test_add_from_raw_buffer():
+    buffer = juce.AudioBufferDouble(1, 16)
+    np.asarray(buffer)[:] = 1.0
+
+    source = np.full(16, 0.25, dtype=np.float64)
+    buffer.addFrom(0, 0, source, 16)
+    assert np.allclose(np.asarray(buffer), 1.25)
+
+    buffer.addFrom(0, 0, memoryview(source), 8, 2.0)
+    assert np.allclose(np.asarray(buffer)[0, :8], 1.75)
+    assert np.allclose(np.asarray(buffer)[0, 8:], 1.25)
+
+#==================================================================================================
+
+def test_copy_and_add_from_raw_buffer_with_ramp():
+    buffer = juce.AudioBufferFloat(1, 5)
+    source = np.ones(5, dtype=np.float32)
+
+    buffer.copyFromWithRamp(0, 0, source, 5, 0.0, 1.0)
+    assert np.allclose(np.asarray(buffer)[0], [0.0, 0.2, 0.4, 0.6, 0.8])
+
+    buffer.addFromWithRamp(0, 0, source, 5, 1.0, 0.0)
+    assert np.allclose(np.asarray(buffer)[0], 1.0)
+
+#==================================================================================================
+
+def test_copy_from_array_view():
+    source = juce.AudioBufferFloat(1, 32)
+    np.asarray(source)[:] = 0.75
+
+    buffer = juce.AudioBufferFloat(1, 32)
+    buffer.copyFrom(0, 0, source.getReadPointer(0), 32)
+    assert np.allclose(np.asarray(buffer), 0.75)
+
+#==================================================================================================
+
+def test_copy_from_raw_buffer_invalid():
+    buffer = juce.AudioBufferFloat(2, 16)
+
+    with pytest.raises(RuntimeError):
+        buffer.copyFrom(0, 0, np.zeros(16, dtype=np.float64), 16)
+
+    with pytest.raises(RuntimeError):
+        buffer.copyFrom(0, 0, np.zeros(8, dtype=np.float32), 16)
+
+    with pytest.raises(RuntimeError):
+        buffer.copyFrom(2, 0, np.zeros(16, dtype=np.float32), 16)
+
+    with pytest.raises(RuntimeError):
+        buffer.addFrom(0, 8, np.zeros(16, dtype=np.float32), 16)
+
+    with pytest.raises(RuntimeError):
+        buffer.copyFrom(0, 0, np.zeros(32, dtype=np.float32)[::2], 16)
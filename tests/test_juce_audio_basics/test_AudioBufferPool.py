@@ -0,0 +1,105 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def test_pool_construct():
+    pool = juce.AudioBufferPoolFloat(4, 2, 256)
+    assert pool.getNumBuffers() == 4
+    assert pool.getNumChannels() == 2
+    assert pool.getNumSamples() == 256
+    assert pool.getNumAvailable() == 4
+    assert pool.getNumInUse() == 0
+    assert pool.getHighWaterMark() == 0
+
+    pool = juce.AudioBufferPoolDouble()
+    assert pool.getNumBuffers() == 0
+    assert pool.acquire() is None
+
+#==================================================================================================
+
+def test_pool_acquire_release():
+    pool = juce.AudioBufferPoolFloat(2, 1, 64)
+
+    a = pool.acquire()
+    b = pool.acquire()
+    assert isinstance(a, juce.AudioBufferFloat)
+    assert a is not b
+    assert a.getNumChannels() == 1
+    assert a.getNumSamples() == 64
+    assert pool.getNumInUse() == 2
+
+    assert pool.acquire() is None
+    assert pool.getNumFailedAcquires() == 1
+
+    pool.release(a)
+    assert pool.getNumAvailable() == 1
+    assert pool.acquire() is a
+
+    pool.release(a)
+    pool.release(b)
+    assert pool.getHighWaterMark() == 2
+
+    pool.resetStatistics()
+    assert pool.getHighWaterMark() == 0
+    assert pool.getNumFailedAcquires() == 0
+
+#==================================================================================================
+
+def test_pool_views():
+    pool = juce.AudioBufferPoolFloat(1, 2, 32, np.asarray)
+
+    view = pool.acquireView()
+    assert isinstance(view, np.ndarray)
+    assert view.shape == (2, 32)
+    assert not np.any(view)
+
+    buffer = pool.getBuffer(view)
+    assert pool.getView(buffer) is view
+
+    view[1, :] = 0.5
+    assert buffer.getSample(1, 31) == pytest.approx(0.5)
+
+    pool.release(buffer)
+    assert pool.getNumInUse() == 0
+
+#==================================================================================================
+
+def test_pool_default_views():
+    pool = juce.AudioBufferPoolDouble(1, 1, 8)
+
+    view = pool.acquireView()
+    assert isinstance(view, memoryview)
+    assert view.shape == (1, 8)
+    pool.release(view)
+
+#==================================================================================================
+
+def test_pool_invalid_release():
+    pool = juce.AudioBufferPoolFloat(1, 1, 8)
+
+    with pytest.raises(RuntimeError):
+        pool.release(juce.AudioBufferFloat(1, 8))
+
+    buffer = pool.acquire()
+    pool.release(buffer)
+
+    with pytest.raises(RuntimeError):
+        pool.release(buffer)
+
+#==================================================================================================
+
+def test_pool_prepare():
+    pool = juce.AudioBufferPoolFloat(1, 1, 8)
+
+    buffer = pool.acquire()
+    with pytest.raises(RuntimeError):
+        pool.prepare(2, 2, 16)
+
+    pool.release(buffer)
+    pool.prepare(2, 2, 16)
+    assert pool.getNumBuffers() == 2
+    assert not pool.owns(buffer)
+    assert pool.acquire().getNumSamples() == 16
@@ -0,0 +1,125 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def test_bytes_per_sample():
+    assert juce.AudioData.getBytesPerSample(juce.AudioData.int8) == 1
+    assert juce.AudioData.getBytesPerSample(juce.AudioData.uint8) == 1
+    assert juce.AudioData.getBytesPerSample(juce.AudioData.int16) == 2
+    assert juce.AudioData.getBytesPerSample(juce.AudioData.int24) == 3
+    assert juce.AudioData.getBytesPerSample(juce.AudioData.int32) == 4
+    assert juce.AudioData.getBytesPerSample(juce.AudioData.float32) == 4
+
+#==================================================================================================
+
+def test_interleave_int16():
+    buffer = juce.AudioBufferFloat(2, 4)
+    array = np.asarray(buffer)
+    array[0] = [0.0, 0.5, -0.5, 1.0]
+    array[1] = [0.25, -0.25, 0.0, -1.0]
+
+    dest = np.zeros(8, dtype="<i2")
+    assert juce.AudioData.interleaveSamples(buffer, dest, juce.AudioData.int16) == 4
+
+    expected = np.empty(8, dtype=np.float32)
+    expected[0::2] = array[0]
+    expected[1::2] = array[1]
+    assert np.allclose(dest / 32767.0, expected, atol=1.0 / 16384)
+
+#==================================================================================================
+
+def test_interleave_deinterleave_roundtrip():
+    source = juce.AudioBufferFloat(3, 256)
+    np.asarray(source)[:] = np.random.uniform(-1.0, 1.0, (3, 256)).astype(np.float32)
+
+    for format, tolerance in [
+        (juce.AudioData.int16, 1.0e-4),
+        (juce.AudioData.int24, 1.0e-6),
+        (juce.AudioData.int32, 1.0e-6),
+        (juce.AudioData.float32, 0.0) ]:
+        for endianness in [juce.AudioData.littleEndian, juce.AudioData.bigEndian]:
+            data = bytearray(3 * 256 * juce.AudioData.getBytesPerSample(format))
+            assert juce.AudioData.interleaveSamples(source, data, format, endianness) == 256
+
+            dest = juce.AudioBufferFloat(3, 256)
+            assert juce.AudioData.deinterleaveSamples(bytes(data), dest, format, endianness) == 256
+            assert np.allclose(np.asarray(dest), np.asarray(source), atol=tolerance)
+
+#==================================================================================================
+
+def test_deinterleave_big_endian_int24():
+    data = bytes([0x40, 0x00, 0x00, 0xc0, 0x00, 0x00])
+
+    dest = juce.AudioBufferFloat(2, 1)
+    assert juce.AudioData.deinterleaveSamples(data, dest, juce.AudioData.int24, juce.AudioData.bigEndian) == 1
+    assert dest.getSample(0, 0) == pytest.approx(0.5)
+    assert dest.getSample(1, 0) == pytest.approx(-0.5)
+
+#==================================================================================================
+
+def test_deinterleave_partial_range():
+    data = np.full(8, 16384, dtype="<i2")
+
+    dest = juce.AudioBufferFloat(2, 8)
+    dest.clear()
+    assert juce.AudioData.deinterleaveSamples(data, dest, juce.AudioData.int16, startSample=4) == 4
+
+    array = np.asarray(dest)
+    assert not np.any(array[:, :4])
+    assert np.allclose(array[:, 4:], 0.5, atol=1.0e-4)
+
+#==================================================================================================
+
+def test_convert_samples():
+    source = np.array([-1.0, -0.5, 0.0, 0.5], dtype=np.float32)
+    dest = np.zeros(4, dtype=">i2")
+
+    assert juce.AudioData.convertSamples(
+        source, juce.AudioData.float32, juce.AudioData.littleEndian,
+        dest, juce.AudioData.int16, juce.AudioData.bigEndian) == 4
+
+    assert np.allclose(dest.astype(np.float32) / 32767.0, source, atol=1.0e-4)
+
+#==================================================================================================
+
+def test_convert_samples_integer_lossless():
+    source = np.array([0x12345601, -0x7654321f, 0x000000ff, -1, 2**31 - 1, -2**31], dtype="<i4")
+    swapped = np.zeros(len(source), dtype=">i4")
+
+    assert juce.AudioData.convertSamples(
+        source, juce.AudioData.int32, juce.AudioData.littleEndian,
+        swapped, juce.AudioData.int32, juce.AudioData.bigEndian) == len(source)
+    assert np.array_equal(swapped, source)
+
+    roundtrip = np.zeros(len(source), dtype="<i4")
+    juce.AudioData.convertSamples(
+        swapped, juce.AudioData.int32, juce.AudioData.bigEndian,
+        roundtrip, juce.AudioData.int32, juce.AudioData.littleEndian)
+    assert np.array_equal(roundtrip, source)
+
+    int24 = np.array([0x01, 0x00, 0x80, 0xff, 0xff, 0x7f], dtype=np.uint8)
+    widened = np.zeros(2, dtype="<i4")
+    juce.AudioData.convertSamples(
+        int24, juce.AudioData.int24, juce.AudioData.littleEndian,
+        widened, juce.AudioData.int32, juce.AudioData.littleEndian)
+    assert list(widened) == [-0x7fffff00, 0x7fffff00]
+
+#==================================================================================================
+
+def test_invalid_pcm_buffers():
+    buffer = juce.AudioBufferFloat(2, 16)
+
+    with pytest.raises(RuntimeError):
+        juce.AudioData.interleaveSamples(buffer, bytearray(10), juce.AudioData.int16, numSamples=16)
+
+    with pytest.raises(BufferError):
+        juce.AudioData.interleaveSamples(buffer, bytes(64), juce.AudioData.int16)
+
+    with pytest.raises(RuntimeError):
+        juce.AudioData.deinterleaveSamples(bytes(128), buffer, juce.AudioData.int16, startSample=17)
+
+    with pytest.raises(RuntimeError):
+        juce.AudioData.deinterleaveSamples(np.zeros(64, dtype=np.int16)[::2], buffer, juce.AudioData.int16)
@@ -0,0 +1,93 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def test_fifo_write_and_read():
+    fifo = juce.AudioFifo(2, 16)
+    assert fifo.getNumChannels() == 2
+    assert fifo.getCapacity() == 16
+    assert fifo.getFreeSpace() == 16
+    assert fifo.getNumReady() == 0
+
+    source = np.arange(20, dtype=np.float32).reshape(2, 10)
+    assert fifo.write(source) == 10
+    assert fifo.getNumReady() == 10
+
+    dest = np.zeros((2, 6), dtype=np.float32)
+    assert fifo.read(dest) == 6
+    assert np.array_equal(dest, source[:, :6])
+
+    assert fifo.read(dest) == 4
+    assert np.array_equal(dest[:, :4], source[:, 6:])
+    assert not np.any(dest[:, 4:])
+    assert fifo.getNumUnderruns() == 1
+
+#==================================================================================================
+
+def test_fifo_overrun():
+    fifo = juce.AudioFifo(1, 8)
+
+    assert fifo.write(np.ones(6, dtype=np.float32)) == 6
+    assert fifo.write(np.ones(6, dtype=np.float32)) == 2
+    assert fifo.getNumOverruns() == 1
+
+    fifo.resetCounters()
+    assert fifo.getNumOverruns() == 0
+
+    fifo.reset()
+    assert fifo.getNumReady() == 0
+
+#==================================================================================================
+
+def test_fifo_channel_lists():
+    fifo = juce.AudioFifo(2, 32)
+
+    left = np.full(8, 0.25, dtype=np.float32)
+    right = np.full(8, -0.25, dtype=np.float32)
+    assert fifo.write([left, right]) == 8
+
+    buffer = juce.AudioBufferFloat(2, 8)
+    assert fifo.read(buffer.getArrayOfWritePointers()) == 8
+    assert buffer.getSample(0, 7) == pytest.approx(0.25)
+    assert buffer.getSample(1, 0) == pytest.approx(-0.25)
+
+    with pytest.raises(RuntimeError):
+        fifo.write([left, np.zeros(4, dtype=np.float32)])
+
+#==================================================================================================
+
+def test_fifo_regions_wrap_around():
+    fifo = juce.AudioFifo(2, 8)
+
+    fifo.write(np.zeros((2, 6), dtype=np.float32))
+    fifo.read(np.zeros((2, 6), dtype=np.float32))
+
+    first, second = fifo.prepareToWrite(5)
+    assert first.getNumSamples() + second.getNumSamples() == 5
+    assert second.getNumSamples() > 0
+
+    first_view = np.asarray(first)
+    second_view = np.asarray(second)
+    assert first_view.shape == (2, first.getNumSamples())
+    first_view[:] = 1.0
+    second_view[:] = 2.0
+    fifo.finishedWrite(5)
+
+    first, second = fifo.prepareToRead(5)
+    assert first.isReadOnly()
+    data = np.concatenate([np.asarray(first), np.asarray(second)], axis=1)
+    fifo.finishedRead(5)
+
+    assert data.shape == (2, 5)
+    assert np.all(data[:, :first.getNumSamples()] == 1.0)
+    assert np.all(data[:, first.getNumSamples():] == 2.0)
+
+#==================================================================================================
+
+def test_fifo_region_keeps_fifo_alive():
+    first, _ = juce.AudioFifo(1, 4).prepareToWrite(4)
+    np.asarray(first)[:] = 1.0
+    assert first.getNumSamples() == 4
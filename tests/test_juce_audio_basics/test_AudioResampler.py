@@ -0,0 +1,75 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def sine(frequency, sampleRate, numSamples, numChannels=1):
+    phase = 2.0 * np.pi * frequency * np.arange(numSamples) / sampleRate
+    return np.tile(np.sin(phase), (numChannels, 1)).astype(np.float32)
+
+#==================================================================================================
+
+def test_num_output_samples():
+    assert juce.AudioResampler.getNumOutputSamples(100, 1.0) == 100
+    assert juce.AudioResampler.getNumOutputSamples(100, 2.0) == 50
+    assert juce.AudioResampler.getNumOutputSamples(101, 2.0) == 51
+    assert juce.AudioResampler.getNumOutputSamples(100, 0.5) == 200
+
+    with pytest.raises(RuntimeError):
+        juce.AudioResampler.getNumOutputSamples(100, 0.0)
+
+#==================================================================================================
+
+@pytest.mark.parametrize("quality", [
+    juce.AudioResampler.Quality.linear,
+    juce.AudioResampler.Quality.catmullRom,
+    juce.AudioResampler.Quality.lagrange,
+    juce.AudioResampler.Quality.windowedSinc,
+])
+def test_resample_unity_ratio_is_aligned(quality):
+    source = sine(440.0, 44100.0, 2048, numChannels=2)
+
+    result = np.array(juce.AudioResampler.resample(source, 1.0, quality))
+    assert result.shape == source.shape
+    assert np.allclose(result[:, 8:-8], source[:, 8:-8], atol=1e-3)
+
+#==================================================================================================
+
+def test_resample_to_other_rate():
+    source = sine(1000.0, 48000.0, 48000, numChannels=2)
+
+    result = np.array(juce.AudioResampler.resample(source, 48000.0 / 44100.0))
+    assert result.shape == (2, 44100)
+
+    expected = sine(1000.0, 44100.0, 44100, numChannels=2)
+    assert np.allclose(result[:, 256:-256], expected[:, 256:-256], atol=1e-2)
+
+#==================================================================================================
+
+def test_process_into_buffer():
+    source = sine(440.0, 44100.0, 1000)
+    dest = juce.AudioBufferFloat(1, 600)
+    dest.clear()
+
+    assert juce.AudioResampler.process(source, dest, 2.0, juce.AudioResampler.Quality.lagrange, numThreads=1) == 500
+    assert np.allclose(np.array(dest)[0, 4:490], source[0, 8:980:2], atol=1e-2)
+    assert not np.any(np.array(dest)[0, 500:])
+
+    with pytest.raises(RuntimeError):
+        juce.AudioResampler.process(source, np.zeros((2, 500), dtype=np.float32), 2.0)
+
+#==================================================================================================
+
+def test_resample_batch():
+    sources = [sine(440.0, 48000.0, 4800), sine(440.0, 96000.0, 9600, numChannels=2)]
+
+    results = juce.AudioResampler.resampleBatch(sources, [48000.0 / 44100.0, 96000.0 / 44100.0])
+    assert len(results) == 2
+    assert np.array(results[0]).shape == (1, 4410)
+    assert np.array(results[1]).shape == (2, 4410)
+    assert np.allclose(np.array(results[0])[0, 256:-256], np.array(results[1])[0, 256:-256], atol=1e-2)
+
+    with pytest.raises(RuntimeError):
+        juce.AudioResampler.resampleBatch(sources, [1.0])
@@ -0,0 +1,167 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def render(source, numChannels=2, numSamples=512):
+    buffer = juce.AudioBufferFloat(numChannels, numSamples)
+    buffer.clear()
+    source.getNextAudioBlock(juce.AudioSourceChannelInfo(buffer))
+    return np.array(buffer)
+
+#==================================================================================================
+
+def test_graph_tone_and_gain():
+    graph = juce.AudioSourceGraph({
+        "type": "gain",
+        "id": "out",
+        "gain": 0.5,
+        "input": { "type": "tone", "id": "osc", "frequency": 440.0, "amplitude": 1.0 }
+    })
+
+    assert graph.getNumNodes() == 2
+    assert sorted(graph.getNodeIds()) == ["osc", "out"]
+    assert graph.hasNode("osc")
+    assert not graph.hasNode("missing")
+
+    graph.prepareToPlay(512, 44100.0)
+
+    output = render(graph)
+    assert np.max(np.abs(output)) == pytest.approx(0.5, abs=0.01)
+
+    assert graph.setParameter("out", "gain", 0.0)
+    assert graph.getNumPendingCommands() == 1
+
+    render(graph)
+    assert graph.getNumPendingCommands() == 0
+    assert not np.any(render(graph))
+
+    graph.releaseResources()
+
+#==================================================================================================
+
+def test_graph_mixer():
+    graph = juce.AudioSourceGraph({
+        "type": "mixer",
+        "inputs": [
+            { "type": "tone", "frequency": 100.0, "amplitude": 0.25 },
+            { "type": "reverb", "id": "verb", "wetLevel": 0.0, "dryLevel": 1.0,
+              "input": { "type": "iirFilter", "id": "filter", "filter": "lowPass", "frequency": 5000.0,
+                         "input": { "type": "tone", "frequency": 200.0, "amplitude": 0.25 } } }
+        ]
+    })
+
+    assert graph.getNumNodes() == 5
+
+    graph.prepareToPlay(512, 44100.0)
+    assert np.any(render(graph))
+
+    assert graph.setParameter("filter", "frequency", 1000.0)
+    assert graph.setParameter("verb", "roomSize", 0.8)
+    assert np.any(render(graph))
+
+#==================================================================================================
+
+def test_graph_external_source():
+    tone = juce.ToneGeneratorAudioSource()
+    tone.setAmplitude(0.5)
+
+    graph = juce.AudioSourceGraph({ "type": "gain", "gain": 1.0, "input": { "type": "source", "source": tone } })
+    graph.prepareToPlay(256, 48000.0)
+    assert np.any(render(graph, numSamples=256))
+
+#==================================================================================================
+
+def test_graph_rejects_python_sources():
+    class CustomSource(juce.AudioSource):
+        def prepareToPlay(self, samplesPerBlockExpected, sampleRate):
+            pass
+
+        def releaseResources(self):
+            pass
+
+        def getNextAudioBlock(self, bufferToFill):
+            pass
+
+    with pytest.raises(RuntimeError):
+        juce.AudioSourceGraph({ "type": "source", "source": CustomSource() })
+
+#==================================================================================================
+
+def test_graph_native_wrapper_of_python_source_still_renders():
+    class CustomSource(juce.AudioSource):
+        def __init__(self):
+            juce.AudioSource.__init__(self)
+            self.calls = 0
+
+        def prepareToPlay(self, samplesPerBlockExpected, sampleRate):
+            pass
+
+        def releaseResources(self):
+            pass
+
+        def getNextAudioBlock(self, bufferToFill):
+            self.calls += 1
+            bufferToFill.clearActiveBufferRegion()
+
+    custom = CustomSource()
+    wrapper = juce.ResamplingAudioSource(custom, False, 2)
+
+    graph = juce.AudioSourceGraph({ "type": "source", "source": wrapper })
+    graph.prepareToPlay(256, 48000.0)
+    render(graph, numSamples=256)
+    assert custom.calls > 0
+
+#==================================================================================================
+
+def test_graph_invalid_descriptions():
+    with pytest.raises(RuntimeError):
+        juce.AudioSourceGraph({ "type": "unknown" })
+
+    with pytest.raises(RuntimeError):
+        juce.AudioSourceGraph({ "type": "gain" })
+
+    with pytest.raises(RuntimeError):
+        juce.AudioSourceGraph({ "type": "iirFilter", "filter": "unknown", "input": { "type": "tone" } })
+
+    with pytest.raises(RuntimeError):
+        juce.AudioSourceGraph({ "type": "mixer", "inputs": [ { "type": "tone", "id": "a" }, { "type": "tone", "id": "a" } ] })
+
+    graph = juce.AudioSourceGraph({ "type": "tone", "id": "osc" })
+
+    with pytest.raises(RuntimeError):
+        graph.setParameter("osc", "ratio", 2.0)
+
+    with pytest.raises(RuntimeError):
+        graph.setParameter("missing", "frequency", 2.0)
+
+#==================================================================================================
+
+def test_graph_command_queue_overflow():
+    graph = juce.AudioSourceGraph({ "type": "tone", "id": "osc" }, maxPendingCommands=2)
+
+    assert graph.setParameter("osc", "frequency", 100.0)
+    assert graph.setParameter("osc", "frequency", 200.0)
+    assert not graph.setParameter("osc", "frequency", 300.0)
+    assert graph.getNumDroppedCommands() == 1
+
+#==================================================================================================
+
+def test_graph_meter_node():
+    meter = juce.LevelMeterBank(2)
+
+    graph = juce.AudioSourceGraph({
+        "type": "meter",
+        "meter": meter,
+        "input": { "type": "tone", "frequency": 440.0, "amplitude": 0.5 }
+    })
+
+    graph.prepareToPlay(512, 44100.0)
+    render(graph)
+
+    snapshot = np.asarray(meter.getSnapshot())
+    assert snapshot[0, juce.LevelMeterBank.peakField] == pytest.approx(0.5, abs=0.01)
+
+    graph.releaseResources()
@@ -0,0 +1,71 @@
+import pytest
+import time
+
+import popsicle as juce
+
+#==================================================================================================
+
+def make_position(isPlaying=True):
+    position = juce.AudioPlayHead.PositionInfo()
+    position.setIsPlaying(isPlaying)
+    position.setTimeInSamples(1000)
+    position.setTimeInSeconds(1000.0 / 48000.0)
+    position.setBpm(120.0)
+    position.setPpqPosition(4.0)
+    return position
+
+#==================================================================================================
+
+def test_cached_position():
+    playHead = juce.CachedAudioPlayHead()
+    assert playHead.getPosition() is None
+    assert playHead.getNumUpdates() == 0
+
+    playHead.setPosition(make_position())
+    assert playHead.getNumUpdates() == 1
+
+    position = playHead.getPosition()
+    assert position.getTimeInSamples() == 1000
+    assert position.getBpm() == 120.0
+    assert position.getPpqPosition() == 4.0
+
+    playHead.setPosition(None)
+    assert playHead.getPosition() is None
+
+#==================================================================================================
+
+def test_cached_position_extrapolation():
+    playHead = juce.CachedAudioPlayHead()
+    playHead.setExtrapolation(True, 48000.0)
+    assert playHead.isExtrapolating()
+    assert playHead.getSampleRate() == 48000.0
+
+    playHead.setPosition(make_position())
+    time.sleep(0.05)
+
+    position = playHead.getPosition()
+    assert position.getTimeInSamples() > 1000 + 48000 * 0.04
+    assert position.getPpqPosition() > 4.0 + 2.0 * 0.04
+
+    playHead.setPosition(make_position(isPlaying=False))
+    time.sleep(0.01)
+    assert playHead.getPosition().getTimeInSamples() == 1000
+
+#==================================================================================================
+
+def test_cached_position_extrapolation_wraps_loop():
+    playHead = juce.CachedAudioPlayHead()
+    playHead.setExtrapolation(True, 48000.0)
+
+    loopPoints = juce.AudioPlayHead.LoopPoints()
+    loopPoints.ppqStart = 0.0
+    loopPoints.ppqEnd = 4.0
+
+    position = make_position()
+    position.setPpqPosition(3.99)
+    position.setIsLooping(True)
+    position.setLoopPoints(loopPoints)
+    playHead.setPosition(position)
+
+    time.sleep(0.05)
+    assert playHead.getPosition().getPpqPosition() < 1.0
@@ -0,0 +1,180 @@
+import time
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+class SlowSource(juce.AudioSource):
+    def __init__(self):
+        juce.AudioSource.__init__(self)
+        self.delay = 0.0
+        self.calls = 0
+
+    def prepareToPlay(self, samplesPerBlockExpected, sampleRate):
+        pass
+
+    def releaseResources(self):
+        pass
+
+    def getNextAudioBlock(self, bufferToFill):
+        self.calls += 1
+        if self.delay > 0.0:
+            time.sleep(self.delay)
+        np.asarray(bufferToFill.buffer)[:] = 0.5
+
+#==================================================================================================
+
+def render(source, numSamples=512):
+    buffer = juce.AudioBufferFloat(2, numSamples)
+    buffer.clear()
+    source.getNextAudioBlock(juce.AudioSourceChannelInfo(buffer))
+    return np.array(buffer)
+
+#==================================================================================================
+
+def test_native_sources_have_no_monitor():
+    assert juce.ToneGeneratorAudioSource().getDeadlineMonitor() is None
+
+#==================================================================================================
+
+def test_monitor_disabled_by_default():
+    source = SlowSource()
+    source.prepareToPlay(512, 44100.0)
+
+    monitor = source.getDeadlineMonitor()
+    assert monitor is not None
+    assert not monitor.isEnabled()
+
+    render(source)
+    assert monitor.getNumCallbacks() == 0
+
+#==================================================================================================
+
+def test_monitor_histogram():
+    source = SlowSource()
+    source.prepareToPlay(512, 44100.0)
+
+    monitor = source.getDeadlineMonitor()
+    monitor.setEnabled(True)
+
+    render(source)
+    assert monitor.getNumCallbacks() == 1
+    assert monitor.getNumMisses() == 0
+
+    histogram = monitor.getHistogram()
+    assert len(histogram) == len(juce.CallbackDeadlineMonitor.getHistogramBinEdges()) + 1
+    assert sum(histogram) == 1
+
+    source.delay = 0.05
+    render(source)
+    assert monitor.getNumMisses() == 1
+    assert monitor.getHistogram()[-1] == 1
+    assert monitor.getMaxCallbackMilliseconds() >= 40.0
+
+    monitor.resetStatistics()
+    assert monitor.getNumCallbacks() == 0
+    assert sum(monitor.getHistogram()) == 0
+
+#==================================================================================================
+
+def test_monitor_repeat_last_block_fallback():
+    source = SlowSource()
+    source.prepareToPlay(512, 44100.0)
+
+    monitor = source.getDeadlineMonitor()
+    monitor.setEnabled(True)
+    monitor.setFallbackPolicy(juce.CallbackDeadlineMonitor.repeatLastBlock, 2)
+
+    render(source)
+
+    source.delay = 0.05
+    render(source)
+    assert not monitor.isInFallback()
+    render(source)
+    assert monitor.isInFallback()
+
+    calls = source.calls
+    output = render(source)
+    assert source.calls == calls
+    assert np.allclose(output, 0.5)
+    assert monitor.getNumFallbackBlocks() == 1
+
+    source.delay = 0.0
+    monitor.resetFallback()
+    render(source)
+    assert source.calls == calls + 1
+
+#==================================================================================================
+
+def test_monitor_repeat_last_block_restores_all_channels():
+    source = SlowSource()
+
+    monitor = source.getDeadlineMonitor()
+    monitor.setMaxNumChannels(12)
+    source.prepareToPlay(256, 44100.0)
+
+    monitor.setEnabled(True)
+    monitor.setFallbackPolicy(juce.CallbackDeadlineMonitor.repeatLastBlock)
+
+    buffer = juce.AudioBufferFloat(12, 256)
+    buffer.clear()
+    source.getNextAudioBlock(juce.AudioSourceChannelInfo(buffer))
+
+    source.delay = 0.05
+    source.getNextAudioBlock(juce.AudioSourceChannelInfo(buffer))
+    assert monitor.isInFallback()
+
+    buffer.clear()
+    source.getNextAudioBlock(juce.AudioSourceChannelInfo(buffer))
+    assert monitor.getNumFallbackBlocks() == 1
+    assert monitor.getNumTruncatedBlocks() == 0
+    assert np.allclose(np.asarray(buffer), 0.5)
+
+#==================================================================================================
+
+def test_monitor_repeat_last_block_truncates_beyond_prepared_storage():
+    source = SlowSource()
+    source.prepareToPlay(256, 44100.0)
+
+    monitor = source.getDeadlineMonitor()
+    assert monitor.getMaxNumChannels() == 8
+    monitor.setEnabled(True)
+    monitor.setFallbackPolicy(juce.CallbackDeadlineMonitor.repeatLastBlock)
+
+    buffer = juce.AudioBufferFloat(12, 512)
+    buffer.clear()
+    source.getNextAudioBlock(juce.AudioSourceChannelInfo(buffer))
+    assert monitor.getNumTruncatedBlocks() == 1
+
+    source.delay = 0.05
+    source.getNextAudioBlock(juce.AudioSourceChannelInfo(buffer))
+    assert monitor.isInFallback()
+
+    buffer.clear()
+    source.getNextAudioBlock(juce.AudioSourceChannelInfo(buffer))
+
+    array = np.asarray(buffer)
+    assert np.allclose(array[:8], 0.5)
+    assert not np.any(array[8:])
+
+#==================================================================================================
+
+def test_monitor_silence_fallback_with_retry():
+    source = SlowSource()
+    source.prepareToPlay(512, 44100.0)
+
+    monitor = source.getDeadlineMonitor()
+    monitor.setEnabled(True)
+    monitor.setFallbackPolicy(juce.CallbackDeadlineMonitor.silence)
+    monitor.setRetryInterval(2)
+
+    source.delay = 0.05
+    render(source)
+    assert monitor.isInFallback()
+
+    source.delay = 0.0
+    assert not np.any(render(source))
+    assert np.allclose(render(source), 0.5)
+    assert not monitor.isInFallback()
@@ -0,0 +1,85 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def test_meter_levels():
+    meter = juce.LevelMeterBank(2)
+    assert meter.getNumChannels() == 2
+    assert juce.LevelMeterBank.numFields == 4
+
+    source = np.zeros((2, 64), dtype=np.float32)
+    source[0, :] = 0.5
+    source[1, 10] = -0.25
+    meter.process(source)
+
+    snapshot = np.asarray(meter.getSnapshot())
+    assert snapshot.shape == (2, 4)
+    assert snapshot[0, juce.LevelMeterBank.peakField] == pytest.approx(0.5)
+    assert snapshot[0, juce.LevelMeterBank.rmsField] == pytest.approx(0.5)
+    assert snapshot[1, juce.LevelMeterBank.peakField] == pytest.approx(0.25)
+    assert snapshot[1, juce.LevelMeterBank.rmsField] == pytest.approx(0.25 / 8.0)
+    assert snapshot[1, juce.LevelMeterBank.truePeakField] >= 0.25
+    assert snapshot[0, juce.LevelMeterBank.clipCountField] == 0
+
+#==================================================================================================
+
+def test_meter_true_peak_and_clips():
+    meter = juce.LevelMeterBank(1, clipThreshold=0.9)
+    assert meter.getClipThreshold() == pytest.approx(0.9)
+
+    phase = np.arange(256) * 2.0 * np.pi / 4.0 + np.pi / 4.0
+    meter.process([np.sin(phase).astype(np.float32)])
+
+    snapshot = np.zeros((1, 4), dtype=np.float64)
+    assert meter.getSnapshot(snapshot)
+    assert snapshot[0, juce.LevelMeterBank.peakField] == pytest.approx(np.sqrt(0.5), abs=1e-6)
+    assert snapshot[0, juce.LevelMeterBank.truePeakField] > 0.85
+    assert snapshot[0, juce.LevelMeterBank.clipCountField] == 0
+
+    meter.process(np.full((1, 16), 1.0, dtype=np.float32))
+    assert meter.getSnapshot(snapshot)
+    assert snapshot[0, juce.LevelMeterBank.clipCountField] == 16
+
+#==================================================================================================
+
+def test_meter_accumulates_until_read():
+    meter = juce.LevelMeterBank(1)
+
+    meter.process(np.full(32, 0.8, dtype=np.float32))
+    meter.process(np.full(32, 0.1, dtype=np.float32))
+
+    snapshot = np.zeros((1, 4), dtype=np.float64)
+    assert meter.getSnapshot(snapshot)
+    assert snapshot[0, juce.LevelMeterBank.peakField] == pytest.approx(0.8)
+    assert not meter.getSnapshot(snapshot)
+
+    meter.process(np.full(32, 0.1, dtype=np.float32))
+    assert meter.getSnapshot(snapshot)
+    assert snapshot[0, juce.LevelMeterBank.peakField] == pytest.approx(0.1)
+
+#==================================================================================================
+
+def test_meter_reset():
+    meter = juce.LevelMeterBank(1)
+
+    meter.process(np.full(8, 2.0, dtype=np.float32))
+    meter.reset()
+    meter.process(np.zeros(8, dtype=np.float32))
+
+    snapshot = np.asarray(meter.getSnapshot())
+    assert snapshot[0, juce.LevelMeterBank.peakField] == 0.0
+    assert snapshot[0, juce.LevelMeterBank.clipCountField] == 0
+
+#==================================================================================================
+
+def test_meter_snapshot_buffer_validation():
+    meter = juce.LevelMeterBank(2)
+
+    with pytest.raises(RuntimeError):
+        meter.getSnapshot(np.zeros((1, 4), dtype=np.float64))
+
+    with pytest.raises(RuntimeError):
+        meter.getSnapshot(np.zeros((2, 4), dtype=np.float32))
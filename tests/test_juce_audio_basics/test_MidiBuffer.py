@@ -0,0 +1,154 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def test_midi_message():
+    message = juce.MidiMessage.noteOn(1, 60, 0.5)
+    assert message.isNoteOn()
+    assert message.getChannel() == 1
+    assert message.getNoteNumber() == 60
+    assert message.getRawDataSize() == 3
+    assert message.getRawData()[0] == 0x90
+
+    message = juce.MidiMessage(0xb0, 7, 100, 1.5)
+    assert message.isController()
+    assert message.getControllerValue() == 100
+    assert message.getTimeStamp() == 1.5
+
+    sysex = juce.MidiMessage.createSysExMessage(b"\x01\x02\x03")
+    assert sysex.isSysEx()
+    assert sysex.getSysExData() == b"\x01\x02\x03"
+
+    assert juce.MidiMessage.getMidiNoteName(60, True, True, 4) == "C4"
+
+#==================================================================================================
+
+def test_midi_buffer_events():
+    buffer = juce.MidiBuffer()
+    assert buffer.isEmpty()
+
+    buffer.addEvent(juce.MidiMessage.noteOn(1, 60, 0.5), 10)
+    buffer.addEvent(bytes([0x80, 60, 0]), 20)
+    assert buffer.getNumEvents() == 2
+    assert buffer.getFirstEventTime() == 10
+    assert buffer.getLastEventTime() == 20
+
+    events = list(buffer)
+    assert events[0][0].isNoteOn() and events[0][1] == 10
+    assert events[1][0].isNoteOff() and events[1][1] == 20
+
+#==================================================================================================
+
+def test_midi_buffer_export_events():
+    buffer = juce.MidiBuffer()
+    buffer.addEvent(juce.MidiMessage.noteOn(2, 64, juce.MidiMessage.floatValueToMidiByte(1.0)), 0)
+    buffer.addEvent(juce.MidiMessage.programChange(1, 5), 32)
+    buffer.addEvent(juce.MidiMessage.createSysExMessage(b"\x7e\x00"), 64)
+
+    events, sysex = buffer.exportEvents()
+    records = np.asarray(events)
+    assert len(records) == 3
+    assert list(records["samplePosition"]) == [0, 32, 64]
+    assert list(records["status"]) == [0x91, 0xc0, 0xf0]
+    assert records["data1"][0] == 64
+    assert records["data2"][0] == 127
+    assert records["sysexSize"][2] == 4
+    assert sysex[records["sysexOffset"][2]:] == b"\xf0\x7e\x00\xf7"
+
+    events, sysex = buffer.exportEvents(16, 32)
+    assert len(events) == 1
+    assert sysex == b""
+
+#==================================================================================================
+
+def test_midi_buffer_from_events():
+    records = np.asarray(juce.MidiEventArray(1000))
+    records["samplePosition"] = np.arange(1000)
+    records["status"] = 0x90
+    records["data1"] = np.arange(1000) % 128
+    records["data2"] = 100
+
+    buffer = juce.MidiBuffer.fromEvents(records)
+    assert buffer.getNumEvents() == 1000
+    assert buffer.getLastEventTime() == 999
+
+    events, _ = buffer.exportEvents()
+    assert np.array_equal(np.asarray(events), records)
+
+    buffer.addEvents(records[:2], sampleDeltaToAdd=-1)
+    assert buffer.getNumEvents() == 1002
+    assert buffer.getFirstEventTime() == -1
+
+    sysexRecords = np.asarray(juce.MidiEventArray(1))
+    sysexRecords["status"] = 0xf0
+    sysexRecords["sysexSize"] = 4
+    buffer = juce.MidiBuffer.fromEvents(sysexRecords, b"\xf0\x01\x02\xf7")
+    assert list(buffer)[0][0].getSysExData() == b"\x01\x02"
+
+    with pytest.raises(RuntimeError):
+        juce.MidiBuffer.fromEvents(sysexRecords, b"\xf0")
+
+    with pytest.raises(RuntimeError):
+        juce.MidiBuffer.fromEvents(np.asarray(juce.MidiEventArray(1)))
+
+#==================================================================================================
+
+def test_midi_buffer_add_events_sorts_and_merges():
+    buffer = juce.MidiBuffer()
+    buffer.addEvent(juce.MidiMessage.noteOn(1, 60, 1.0), 10)
+    buffer.addEvent(juce.MidiMessage.noteOff(1, 60), 30)
+
+    records = np.asarray(juce.MidiEventArray(3))
+    records["samplePosition"] = [40, 10, 0]
+    records["status"] = [0x90, 0xb0, 0xc0]
+    records["data1"] = [62, 7, 3]
+
+    buffer.addEvents(records)
+    events, _ = buffer.exportEvents()
+    events = np.asarray(events)
+    assert list(events["samplePosition"]) == [0, 10, 10, 30, 40]
+    assert list(events["status"]) == [0xc0, 0x90, 0xb0, 0x80, 0x90]
+
+#==================================================================================================
+
+def test_midi_buffer_add_events_accepts_equivalent_dtypes():
+    dtype = np.dtype({
+        "names": ["samplePosition", "status", "data1", "data2", "reserved", "sysexOffset", "sysexSize"],
+        "formats": ["<i4", "u1", "u1", "u1", "u1", "<i4", "<i4"],
+        "offsets": [0, 4, 5, 6, 7, 8, 12],
+        "itemsize": 16,
+    })
+
+    records = np.zeros(2, dtype=dtype)
+    records["samplePosition"] = [5, 6]
+    records["status"] = 0x90
+    records["data1"] = 60
+
+    buffer = juce.MidiBuffer.fromEvents(records)
+    assert buffer.getNumEvents() == 2
+    assert buffer.getLastEventTime() == 6
+
+#==================================================================================================
+
+def test_midi_buffer_add_events_rejects_invalid_records_atomically():
+    buffer = juce.MidiBuffer()
+    buffer.addEvent(juce.MidiMessage.noteOn(1, 60, 1.0), 0)
+
+    with pytest.raises(RuntimeError):
+        buffer.addEvents(np.zeros(2, dtype=[("a", "<i8"), ("b", "<i8")]))
+
+    with pytest.raises(RuntimeError):
+        buffer.addEvents(np.zeros(2, dtype=[("samplePosition", "<i4"), ("status", "u1"), ("data1", "u1"), ("data2", "u1"), ("reserved", "u1"), ("sysexSize", "<i4"), ("sysexOffset", "<i4")]))
+
+    records = np.asarray(juce.MidiEventArray(3))
+    records["samplePosition"] = [1, 2, 3]
+    records["status"] = [0x90, 0x90, 0x10]
+
+    with pytest.raises(RuntimeError):
+        buffer.addEvents(records)
+
+    assert buffer.getNumEvents() == 1
+    assert buffer.getLastEventTime() == 0
@@ -0,0 +1,72 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def make_midi_file_data():
+    track = bytes([
+        0x00, 0xff, 0x51, 0x03, 0x07, 0xa1, 0x20,
+        0x00, 0x90, 0x3c, 0x64,
+        0x60, 0x80, 0x3c, 0x00,
+        0x00, 0xff, 0x2f, 0x00,
+    ])
+
+    header = b"MThd" + bytes([0, 0, 0, 6, 0, 0, 0, 1, 0, 96])
+    return header + b"MTrk" + len(track).to_bytes(4, "big") + track
+
+#==================================================================================================
+
+def test_parse_to_arrays():
+    result = juce.MidiFile.parseToArrays(make_midi_file_data())
+    assert result["fileType"] == 0
+    assert result["timeFormat"] == 96
+    assert len(result["tracks"]) == 1
+
+    events, data = result["tracks"][0]
+    records = np.asarray(events)
+    assert len(records) >= 3
+
+    assert records["status"][0] == 0xff
+    assert records["metaType"][0] == 0x51
+    assert data[records["dataOffset"][0]:records["dataOffset"][0] + records["dataSize"][0]] == b"\x07\xa1\x20"
+
+    assert records["status"][1] == 0x90
+    assert records["data1"][1] == 60
+    assert records["data2"][1] == 100
+
+    assert records["status"][2] == 0x80
+    assert records["tick"][2] == 96.0
+    assert records["timeInSeconds"][2] == pytest.approx(0.5)
+
+#==================================================================================================
+
+def test_parse_from_memory_block_and_file(tmp_path):
+    data = make_midi_file_data()
+
+    result = juce.MidiFile.parseToArrays(juce.MemoryBlock(data))
+    assert len(result["tracks"]) == 1
+
+    path = tmp_path / "test.mid"
+    path.write_bytes(data)
+
+    result = juce.MidiFile.parseToArrays(juce.File(str(path)))
+    assert len(result["tracks"]) == 1
+
+    with pytest.raises(RuntimeError):
+        juce.MidiFile.parseToArrays(b"not a midi file")
+
+#==================================================================================================
+
+def test_parse_batch_to_arrays():
+    data = make_midi_file_data()
+
+    results = juce.MidiFile.parseBatchToArrays([data, b"garbage", data] * 4, numThreads=4)
+    assert len(results) == 12
+
+    for index, result in enumerate(results):
+        if index % 3 == 1:
+            assert result is None
+        else:
+            assert np.asarray(result["tracks"][0][0])["data1"][1] == 60
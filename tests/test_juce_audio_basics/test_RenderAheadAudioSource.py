@@ -0,0 +1,82 @@
+import time
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+class CountingSource(juce.AudioSource):
+    def __init__(self):
+        juce.AudioSource.__init__(self)
+        self.counter = 0
+
+    def prepareToPlay(self, samplesPerBlockExpected, sampleRate):
+        self.counter = 0
+
+    def releaseResources(self):
+        pass
+
+    def getNextAudioBlock(self, bufferToFill):
+        self.counter += 1
+        np.asarray(bufferToFill.buffer)[:] = float(self.counter)
+
+#==================================================================================================
+
+def render(source, numChannels=2, numSamples=256):
+    buffer = juce.AudioBufferFloat(numChannels, numSamples)
+    buffer.clear()
+    source.getNextAudioBlock(juce.AudioSourceChannelInfo(buffer))
+    return np.array(buffer)
+
+#==================================================================================================
+
+def test_render_ahead_latency():
+    source = juce.RenderAheadAudioSource(CountingSource(), numBlocksAhead=4, numChannels=2)
+    assert source.getNumBlocksAhead() == 4
+    assert source.getNumChannels() == 2
+
+    source.prepareToPlay(256, 44100.0)
+    try:
+        assert source.getLatencySamples() == 1024
+        assert source.getLatencySeconds() == pytest.approx(1024 / 44100.0)
+        assert source.isRendering()
+        assert source.getNumReady() == 1024
+    finally:
+        source.releaseResources()
+
+    assert not source.isRendering()
+
+#==================================================================================================
+
+def test_render_ahead_pulls_blocks_in_order():
+    wrapped = CountingSource()
+    source = juce.RenderAheadAudioSource(wrapped, numBlocksAhead=2)
+
+    source.prepareToPlay(128, 44100.0)
+    try:
+        for expected in range(1, 6):
+            deadline = time.monotonic() + 2.0
+            while source.getNumReady() < 128 and time.monotonic() < deadline:
+                time.sleep(0.001)
+
+            output = render(source, numSamples=128)
+            assert np.all(output == float(expected))
+
+        assert source.getNumUnderruns() == 0
+        assert not source.hasFailed()
+    finally:
+        source.releaseResources()
+
+#==================================================================================================
+
+def test_render_ahead_clears_extra_channels():
+    source = juce.RenderAheadAudioSource(CountingSource(), numBlocksAhead=1, numChannels=1)
+
+    source.prepareToPlay(64, 48000.0)
+    try:
+        output = render(source, numChannels=2, numSamples=64)
+        assert np.all(output[0] == 1.0)
+        assert not np.any(output[1])
+    finally:
+        source.releaseResources()
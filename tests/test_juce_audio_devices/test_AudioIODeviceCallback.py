@@ -0,0 +1,225 @@
+import gc
+import time
+import pytest
+import weakref
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+class PassThroughCallback(juce.AudioIODeviceCallback):
+    def __init__(self):
+        juce.AudioIODeviceCallback.__init__(self)
+        self.calls = 0
+        self.view_ids = None
+        self.argument_ids = None
+
+    def audioDeviceIOCallbackWithContext(self, inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples, context):
+        self.calls += 1
+        self.view_ids = [id(view) for view in inputChannelData] + [id(view) for view in outputChannelData]
+        self.argument_ids = [id(inputChannelData), id(outputChannelData), id(numSamples), id(context)]
+
+        for channel in range(numOutputChannels):
+            output = outputChannelData[channel]
+            if channel < numInputChannels:
+                output[0:numSamples] = inputChannelData[channel]
+            else:
+                output.fill(0.0)
+
+    def audioDeviceAboutToStart(self, device):
+        pass
+
+    def audioDeviceStopped(self):
+        pass
+
+class SlowPassThroughCallback(PassThroughCallback):
+    def __init__(self, delay):
+        PassThroughCallback.__init__(self)
+        self.delay = delay
+
+    def audioDeviceIOCallbackWithContext(self, inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples, context):
+        time.sleep(self.delay)
+        PassThroughCallback.audioDeviceIOCallbackWithContext(self, inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples, context)
+
+#==================================================================================================
+
+class FakeDevice(juce.AudioIODevice):
+    def __init__(self, numChannels, bufferSize, sampleRate):
+        juce.AudioIODevice.__init__(self, "Fake", "Test")
+        self.numChannels = numChannels
+        self.bufferSize = bufferSize
+        self.sampleRate = sampleRate
+
+    def getActiveInputChannels(self):
+        return juce.BigInteger((1 << self.numChannels) - 1)
+
+    def getActiveOutputChannels(self):
+        return juce.BigInteger((1 << self.numChannels) - 1)
+
+    def getCurrentBufferSizeSamples(self):
+        return self.bufferSize
+
+    def getCurrentSampleRate(self):
+        return self.sampleRate
+
+def start_device(callback, device, numBlocks):
+    callback.setBlockCoalescing(numBlocks)
+    juce.AudioIODeviceCallback.audioDeviceAboutToStart(callback, device)
+
+def stop_device(callback):
+    juce.AudioIODeviceCallback.audioDeviceStopped(callback)
+
+def wait_for_calls(callback, numCalls, timeout=2.0):
+    deadline = time.monotonic() + timeout
+    while callback.calls < numCalls and time.monotonic() < deadline:
+        time.sleep(0.001)
+
+    # Let the render thread hand the block back after python returned
+    time.sleep(0.02)
+    assert callback.calls == numCalls
+
+#==================================================================================================
+
+def test_render_device_block():
+    callback = PassThroughCallback()
+
+    inputs = np.random.uniform(-1.0, 1.0, (2, 256)).astype(np.float32)
+    outputs = np.zeros((3, 256), dtype=np.float32)
+
+    callback.renderDeviceBlock(inputs, outputs)
+    assert callback.calls == 1
+    assert np.array_equal(outputs[:2], inputs)
+    assert not outputs[2].any()
+
+    with pytest.raises(RuntimeError):
+        callback.renderDeviceBlock(inputs, np.zeros((2, 128), dtype=np.float32))
+
+#==================================================================================================
+
+def test_repeated_callbacks_dont_allocate():
+    callback = PassThroughCallback()
+
+    inputs = np.zeros((2, 512), dtype=np.float32)
+    outputs = np.zeros((2, 512), dtype=np.float32)
+
+    callback.renderDeviceBlock(inputs, outputs)
+    assert callback.getNumPythonAllocationsInLastCallback() > 0
+
+    total_allocations = callback.getTotalNumPythonAllocations()
+    first_view_ids = callback.view_ids
+    first_argument_ids = callback.argument_ids
+
+    for index in range(200):
+        inputs[:] = index
+        callback.renderDeviceBlock(inputs, outputs)
+
+        assert callback.getNumPythonAllocationsInLastCallback() == 0
+        assert callback.view_ids == first_view_ids
+        assert callback.argument_ids == first_argument_ids
+        assert outputs[1, 511] == pytest.approx(float(index))
+
+    assert callback.calls == 201
+    assert callback.getTotalNumPythonAllocations() == total_allocations
+
+#==================================================================================================
+
+def test_channel_layout_change_allocates_once():
+    callback = PassThroughCallback()
+
+    callback.renderDeviceBlock(np.zeros((1, 64), dtype=np.float32), np.zeros((1, 64), dtype=np.float32))
+
+    inputs = np.zeros((4, 64), dtype=np.float32)
+    outputs = np.zeros((4, 64), dtype=np.float32)
+
+    callback.renderDeviceBlock(inputs, outputs)
+    assert callback.getNumPythonAllocationsInLastCallback() > 0
+    total_allocations = callback.getTotalNumPythonAllocations()
+
+    for _ in range(50):
+        callback.renderDeviceBlock(inputs, outputs)
+
+    assert callback.getTotalNumPythonAllocations() == total_allocations
+
+#==================================================================================================
+
+def test_callback_is_collected_after_rendering():
+    callback = PassThroughCallback()
+    callback.renderDeviceBlock(np.zeros((1, 32), dtype=np.float32), np.zeros((1, 32), dtype=np.float32))
+    assert callback.calls == 1
+
+    callback_ref = weakref.ref(callback)
+    del callback
+    gc.collect()
+    assert callback_ref() is None
+
+#==================================================================================================
+
+def test_coalesced_blocks_are_rendered_off_the_audio_thread():
+    callback = PassThroughCallback()
+    start_device(callback, FakeDevice(2, 64, 48000.0), 2)
+    assert callback.getCoalescingLatencySamples() == 256
+
+    inputs = np.zeros((2, 64), dtype=np.float32)
+    outputs = np.zeros((2, 64), dtype=np.float32)
+    rendered = []
+
+    for block in range(12):
+        inputs[:] = np.arange(block * 64, (block + 1) * 64, dtype=np.float32) + 1.0
+        callback.renderDeviceBlock(inputs, outputs)
+        rendered.append(outputs.copy())
+
+        if block % 2 == 1:
+            wait_for_calls(callback, (block + 1) // 2)
+
+    stop_device(callback)
+
+    rendered = np.concatenate(rendered, axis=1)
+    expected = np.concatenate([np.zeros(256, dtype=np.float32), np.arange(1, 12 * 64 - 256 + 1, dtype=np.float32)])
+    assert np.array_equal(rendered[0], expected)
+    assert np.array_equal(rendered[1], expected)
+    assert callback.getNumLateCoalescedBlocks() == 0
+
+#==================================================================================================
+
+def test_coalesced_rendering_has_the_whole_aggregated_block_to_render():
+    hardware_period = 480 / 48000.0
+
+    callback = SlowPassThroughCallback(1.5 * hardware_period)
+    start_device(callback, FakeDevice(1, 480, 48000.0), 4)
+
+    monitor = callback.getDeadlineMonitor()
+    monitor.setEnabled(True)
+
+    inputs = np.ones((1, 480), dtype=np.float32)
+    outputs = np.zeros((1, 480), dtype=np.float32)
+
+    for _ in range(16):
+        callback.renderDeviceBlock(inputs, outputs)
+        time.sleep(hardware_period)
+
+    stop_device(callback)
+
+    assert callback.calls >= 3
+    assert callback.getNumLateCoalescedBlocks() == 0
+    assert monitor.getNumMisses() == 0
+
+#==================================================================================================
+
+def test_late_coalesced_blocks_play_silence():
+    hardware_period = 480 / 48000.0
+
+    callback = SlowPassThroughCallback(0.2)
+    start_device(callback, FakeDevice(1, 480, 48000.0), 2)
+
+    inputs = np.ones((1, 480), dtype=np.float32)
+    outputs = np.ones((1, 480), dtype=np.float32)
+
+    for _ in range(12):
+        callback.renderDeviceBlock(inputs, outputs)
+        time.sleep(hardware_period)
+
+    assert callback.getNumLateCoalescedBlocks() > 0
+    assert not outputs.any()
+
+    stop_device(callback)
@@ -0,0 +1,9 @@
+import pytest
+
+from .utilities import create_manager
+
+#==================================================================================================
+
+@pytest.fixture
+def manager():
+    return create_manager()
@@ -0,0 +1,80 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+from .utilities import write_wav_file
+
+#==================================================================================================
+
+@pytest.fixture
+def wav_files(tmp_path):
+    paths = []
+
+    for index in range(4):
+        samples = np.full((1 + index % 2, 100 * (index + 1)), 4096 * (index + 1), dtype=np.int16)
+        path = tmp_path / f"test{index}.wav"
+        write_wav_file(path, samples)
+        paths.append(path)
+
+    return paths
+
+#==================================================================================================
+
+def test_decode_files(manager, wav_files, tmp_path):
+    results = manager.decodeFiles(wav_files + [tmp_path / "missing.wav"], numThreads=2)
+    assert len(results) == 5
+
+    for index, result in enumerate(results[:4]):
+        assert result.wasSuccessful()
+        assert result.numChannels == 1 + index % 2
+        assert result.sourceSampleRate == 44100.0
+
+        samples = np.asarray(result.samples)
+        assert samples.shape == (1 + index % 2, 100 * (index + 1))
+        assert np.allclose(samples, 0.125 * (index + 1))
+
+    assert not results[4]
+    assert results[4].samples is None
+    assert results[4].error != ""
+
+#==================================================================================================
+
+def test_decode_files_channels_and_range(manager, wav_files):
+    results = manager.decodeFiles([juce.File(str(path)) for path in wav_files], numChannels=2, startSample=50, numSamples=100)
+
+    for index, result in enumerate(results):
+        samples = np.asarray(result.samples)
+        assert samples.shape == (2, 50 if index == 0 else 100)
+        assert np.allclose(samples, 0.125 * (index + 1))
+
+    results = manager.decodeFiles(wav_files, numChannels=1)
+    assert np.asarray(results[1].samples).shape == (1, 200)
+
+    results = manager.decodeFiles(wav_files, startSample=150)
+    assert not results[0]
+    assert results[1].numSamples == 50
+
+#==================================================================================================
+
+def test_decode_files_resampled(manager, wav_files):
+    results = manager.decodeFiles(wav_files, sampleRate=22050.0)
+
+    for index, result in enumerate(results):
+        assert result.sampleRate == 22050.0
+        assert np.asarray(result.samples).shape == (1 + index % 2, 50 * (index + 1))
+
+#==================================================================================================
+
+def test_decode_files_into(manager, wav_files, tmp_path):
+    dest = np.zeros((2, 800), dtype=np.float32)
+
+    results = manager.decodeFilesInto([wav_files[0], tmp_path / "missing.wav"] + wav_files[1:], dest)
+    assert [bool(result) for result in results] == [True, False, True, True, False]
+    assert [result.offset for result in results if result] == [0, 100, 300]
+    assert "space" in results[4].error
+
+    assert np.allclose(dest[:, 0:100], 0.125)
+    assert np.allclose(dest[:, 100:300], 0.25)
+    assert np.allclose(dest[:, 300:600], 0.375)
+    assert not np.any(dest[:, 600:])
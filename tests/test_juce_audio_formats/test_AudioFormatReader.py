@@ -0,0 +1,185 @@
+import pytest
+import time
+import numpy as np
+
+import popsicle as juce
+
+from .utilities import create_reader, write_wav_file
+
+#==================================================================================================
+
+@pytest.fixture
+def wav_samples():
+    return np.array([[0, 16384, -16384, 32767], [1, 2, 3, 4]], dtype=np.int16)
+
+@pytest.fixture
+def reader(tmp_path, wav_samples):
+    path = tmp_path / "test.wav"
+    write_wav_file(path, wav_samples)
+    return create_reader(path)
+
+#==================================================================================================
+
+def test_read_all_as_float(reader, wav_samples):
+    assert reader.lengthInSamples == 4
+
+    samples = np.asarray(reader.readAll())
+    assert samples.dtype == np.float32
+    assert samples.shape == (2, 4)
+    assert np.allclose(samples, wav_samples / 32768.0)
+
+    samples = np.asarray(reader.readAll(startSampleInFile=1, numSamples=2))
+    assert samples.shape == (2, 2)
+    assert np.allclose(samples, wav_samples[:, 1:3] / 32768.0)
+
+    with pytest.raises(RuntimeError):
+        reader.readAll(startSampleInFile=5)
+
+#==================================================================================================
+
+def test_read_all_as_native_integers(reader, wav_samples):
+    samples = np.asarray(reader.readAll(asFloat=False))
+    assert samples.dtype == np.int16
+    assert np.array_equal(samples, wav_samples)
+
+#==================================================================================================
+
+def test_read_into(reader, wav_samples):
+    dest = np.zeros((2, 4), dtype=np.float32)
+    assert reader.readInto(dest)
+    assert np.allclose(dest, wav_samples / 32768.0)
+
+    dest = np.zeros((2, 2), dtype=np.int32)
+    assert reader.readInto(dest, startSampleInFile=2)
+    assert np.array_equal(dest, wav_samples[:, 2:].astype(np.int32) << 16)
+
+    dest = np.zeros(4, dtype=np.int16)
+    assert reader.readInto(dest)
+    assert np.array_equal(dest, wav_samples[0])
+
+    with pytest.raises(RuntimeError):
+        reader.readInto(np.zeros((2, 4), dtype=np.float64))
+
+#==================================================================================================
+
+def test_iterate_blocks(tmp_path):
+    samples = (np.arange(2 * 1000, dtype=np.int32).reshape(2, -1) % 2000 - 1000).astype(np.int16)
+    path = tmp_path / "long.wav"
+    write_wav_file(path, samples)
+
+    reader = create_reader(path)
+    blocks = reader.iterateBlocks(256, numBlocksAhead=2)
+    assert len(blocks) == 4
+
+    result = []
+    for block in blocks:
+        result.append(np.array(block))
+
+    assert [block.shape for block in result] == [(2, 256), (2, 256), (2, 256), (2, 232)]
+    assert np.allclose(np.concatenate(result, axis=1), samples / 32768.0)
+    assert blocks.getNumBlocksRead() == 4
+    assert not blocks.hadReadErrors()
+
+#==================================================================================================
+
+def test_iterate_blocks_range_and_shared_thread(tmp_path):
+    samples = np.arange(1000, dtype=np.int16).reshape(1, -1)
+    path = tmp_path / "mono.wav"
+    write_wav_file(path, samples)
+
+    thread = juce.TimeSliceThread("reader")
+    blocks = juce.AudioFormatReaderBlockIterator(create_reader(path), 100, startSample=50, numSamples=150, thread=thread)
+
+    first = next(blocks)
+    assert blocks.getCurrentBlockStart() == 50
+    assert np.allclose(np.array(first)[0], samples[0, 50:150] / 32768.0)
+
+    second = next(blocks)
+    assert blocks.getCurrentBlockStart() == 150
+    assert np.array(second).shape == (1, 50)
+
+    with pytest.raises(StopIteration):
+        next(blocks)
+
+    blocks.close()
+    thread.stopThread(1000)
+
+    with pytest.raises(RuntimeError):
+        create_reader(path).iterateBlocks(0)
+
+#==================================================================================================
+
+class SlowTimeSliceClient(juce.TimeSliceClient):
+    def __init__(self, numSlices):
+        super().__init__()
+        self.numSlices = numSlices
+
+    def useTimeSlice(self):
+        time.sleep(0.05)
+        self.numSlices -= 1
+        return 0 if self.numSlices > 0 else -1
+
+def test_iterate_blocks_stalls_on_busy_thread(tmp_path):
+    samples = np.arange(1000, dtype=np.int16).reshape(1, -1)
+    path = tmp_path / "busy.wav"
+    write_wav_file(path, samples)
+
+    thread = juce.TimeSliceThread("reader")
+    slow = SlowTimeSliceClient(20)
+    thread.addTimeSliceClient(slow, 0)
+    thread.startThread()
+
+    blocks = juce.AudioFormatReaderBlockIterator(create_reader(path), 100, numBlocksAhead=1, thread=thread)
+    result = [np.array(block) for block in blocks]
+
+    assert np.allclose(np.concatenate(result, axis=1), samples / 32768.0)
+    assert blocks.getNumStalls() > 0
+    assert blocks.getStallSeconds() > 0.0
+
+    blocks.close()
+    while thread.contains(slow):
+        time.sleep(0.01)
+    thread.stopThread(1000)
+
+#==================================================================================================
+
+def test_iterate_blocks_raises_when_thread_stopped(tmp_path):
+    samples = np.arange(1000, dtype=np.int16).reshape(1, -1)
+    path = tmp_path / "stopped.wav"
+    write_wav_file(path, samples)
+
+    thread = juce.TimeSliceThread("reader")
+    blocks = juce.AudioFormatReaderBlockIterator(create_reader(path), 100, numBlocksAhead=1, thread=thread)
+    thread.stopThread(1000)
+
+    with pytest.raises(RuntimeError):
+        for _ in range(3):
+            next(blocks)
+
+    blocks.close()
+
+#==================================================================================================
+
+def test_read_max_levels_batch(tmp_path):
+    rng = np.random.default_rng(7)
+    samples = rng.integers(-20000, 20000, (2, 200000)).astype(np.int16)
+    path = tmp_path / "levels.wav"
+    write_wav_file(path, samples)
+
+    reader = create_reader(path)
+    levels = np.asarray(reader.readMaxLevelsBatch(0, 1000.0, 210))
+    assert levels.shape == (2, 210, 2)
+
+    columns = samples.reshape(2, 200, 1000) / 32768.0
+    assert np.allclose(levels[:, :200, 0], columns.min(axis=2))
+    assert np.allclose(levels[:, :200, 1], columns.max(axis=2))
+    assert not np.any(levels[:, 200:])
+
+    levels = np.asarray(reader.readMaxLevelsBatch(100, 0.5, 4))
+    assert np.allclose(levels[0, :, 0], samples[0, [100, 100, 101, 101]] / 32768.0)
+
+    levels = np.asarray(reader.readMaxLevelsBatch(-500, 1000.0, 2))
+    assert np.allclose(levels[1, 0, 1], samples[1, :500].max() / 32768.0)
+
+    with pytest.raises(RuntimeError):
+        reader.readMaxLevelsBatch(0, 0.0, 10)
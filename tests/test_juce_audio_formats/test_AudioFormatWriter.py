@@ -0,0 +1,89 @@
+import pytest
+import wave
+import numpy as np
+
+import popsicle as juce
+
+#==================================================================================================
+
+def create_writer(path, numChannels, bitsPerSample=16, sampleRate=44100.0):
+    writer = juce.WavAudioFormat().createWriterFor(juce.File(str(path)), sampleRate, numChannels, bitsPerSample)
+    assert writer is not None
+    return writer
+
+def read_wav_file(path):
+    with wave.open(str(path), "rb") as f:
+        assert f.getsampwidth() == 2
+        data = np.frombuffer(f.readframes(f.getnframes()), dtype="<i2")
+        return data.reshape(-1, f.getnchannels()).T
+
+#==================================================================================================
+
+def test_write_from_arrays(tmp_path):
+    path = tmp_path / "out.wav"
+    writer = create_writer(path, 2)
+
+    samples = np.array([[0.0, 0.5, -0.5, 0.25], [0.1, 0.2, 0.3, 0.4]], dtype=np.float32)
+    integers = np.array([[1, 2, 3], [-1, -2, -32768]], dtype=np.int16)
+
+    assert writer.writeFromArrays(samples)
+    assert writer.writeFromArrays(integers)
+    assert writer.writeFromArrays(integers.astype(np.int32) << 16)
+
+    with pytest.raises(RuntimeError):
+        writer.writeFromArrays(np.zeros((1, 4), dtype=np.float32))
+
+    with pytest.raises(RuntimeError):
+        writer.writeFromArrays(np.zeros((2, 4), dtype=np.float64))
+
+    del writer
+
+    data = read_wav_file(path)
+    assert data.shape == (2, 10)
+    assert np.allclose(data[:, :4], samples * 32768.0, atol=1.5)
+    assert np.array_equal(data[:, 4:7], integers)
+    assert np.array_equal(data[:, 7:], integers)
+
+#==================================================================================================
+
+def test_threaded_writer(tmp_path):
+    path = tmp_path / "threaded.wav"
+    writer = create_writer(path, 1)
+
+    threaded = juce.AudioFormatWriter.ThreadedWriter(writer, numSamplesToBuffer=65536)
+    assert threaded.isOpen()
+    assert threaded.getNumChannels() == 1
+
+    blocks = [np.full(1024, index / 16.0, dtype=np.float32) for index in range(10)]
+    for block in blocks:
+        assert threaded.write(block)
+
+    with pytest.raises(RuntimeError):
+        threaded.write(np.zeros((2, 16), dtype=np.float32))
+
+    threaded.close()
+    assert not threaded.isOpen()
+    assert not threaded.write(blocks[0])
+
+    assert threaded.getNumSamplesQueued() == 10 * 1024
+    assert threaded.getNumSamplesDropped() == 1024
+
+    del threaded
+    del writer
+
+    data = read_wav_file(path)
+    assert data.shape == (1, 10 * 1024)
+    assert np.allclose(data[0], np.concatenate(blocks) * 32768.0, atol=1.5)
+
+#==================================================================================================
+
+def test_threaded_writer_drops_when_full(tmp_path):
+    thread = juce.TimeSliceThread("writer")
+    writer = create_writer(tmp_path / "full.wav", 1)
+
+    threaded = juce.AudioFormatWriter.ThreadedWriter(writer, thread, numSamplesToBuffer=1024)
+    assert not threaded.write(np.zeros(4096, dtype=np.float32))
+    assert threaded.getNumSamplesDropped() == 4096
+
+    threaded.close()
+    thread.stopThread(1000)
@@ -0,0 +1,86 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+from .utilities import write_wav_file
+
+#==================================================================================================
+
+@pytest.fixture
+def source(tmp_path):
+    rng = np.random.default_rng(42)
+    samples = (rng.uniform(-0.5, 0.5, (2, 100000)) * 32767).astype(np.int16)
+    samples[1, 50000:] = 0
+    path = tmp_path / "source.wav"
+    write_wav_file(path, samples)
+    return path, samples / 32768.0
+
+#==================================================================================================
+
+def test_build_and_levels(manager, source, tmp_path):
+    path, samples = source
+    sidecar = juce.File(str(tmp_path / "source.peaks"))
+
+    pyramid = juce.AudioPeakPyramid.openOrBuild(manager, juce.File(str(path)), sidecar, samplesPerBin=256, numThreads=4)
+    assert sidecar.existsAsFile()
+    assert pyramid.getNumChannels() == 2
+    assert pyramid.getLengthInSamples() == 100000
+    assert pyramid.getSampleRate() == 44100.0
+    assert pyramid.getNumBins(0) == 391
+    assert pyramid.getNumBins(pyramid.getNumLevels() - 1) == 1
+    assert pyramid.getSamplesPerBin(2) == 1024
+
+    for invalidLevel in (-1, pyramid.getNumLevels(), 64):
+        with pytest.raises(RuntimeError):
+            pyramid.getSamplesPerBin(invalidLevel)
+
+    level = np.asarray(pyramid.getLevel(0))
+    assert level.shape == (391, 2)
+    assert not level.flags.writeable
+
+    bins = samples[0, :256 * 390].reshape(390, 256)
+    assert np.allclose(level["min"][:390, 0] / 32767.0, bins.min(axis=1), atol=1e-3)
+    assert np.allclose(level["max"][:390, 0] / 32767.0, bins.max(axis=1), atol=1e-3)
+    assert np.allclose(level["rms"][:390, 0] / 32767.0, np.sqrt((bins ** 2).mean(axis=1)), atol=1e-3)
+    assert not np.any(level["max"][200:, 1])
+
+    top = np.asarray(pyramid.getLevel(pyramid.getNumLevels() - 1))
+    assert top["max"][0, 0] / 32767.0 == pytest.approx(samples[0].max(), abs=1e-3)
+
+#==================================================================================================
+
+def test_get_peaks(manager, source, tmp_path):
+    path, samples = source
+    pyramid = juce.AudioPeakPyramid.openOrBuild(manager, juce.File(str(path)), juce.File(str(tmp_path / "source.peaks")))
+
+    peaks = np.asarray(pyramid.getPeaks(0, 102400, 100))
+    assert peaks.shape == (2, 100, 3)
+    assert np.allclose(peaks[0, 0, 0], samples[0, :1024].min(), atol=1e-3)
+    assert np.allclose(peaks[0, 0, 1], samples[0, :1024].max(), atol=1e-3)
+    assert not np.any(peaks[1, 50:])
+    assert not np.any(peaks[:, 98:])
+
+    peaks = np.asarray(pyramid.getPeaks(-1000, 500, 10))
+    assert not np.any(peaks)
+
+#==================================================================================================
+
+def test_sidecar_reuse_and_staleness(manager, source, tmp_path):
+    path, samples = source
+    sourceFile = juce.File(str(path))
+    sidecar = juce.AudioPeakPyramid.getDefaultSidecarFile(sourceFile)
+    assert sidecar.getFileName() == "source.wav.peaks"
+
+    assert juce.AudioPeakPyramid.open(sidecar, sourceFile) is None
+
+    juce.AudioPeakPyramid.openOrBuild(manager, sourceFile)
+    assert juce.AudioPeakPyramid.open(sidecar, sourceFile) is not None
+
+    write_wav_file(path, (samples * 16384).astype(np.int16))
+    assert juce.AudioPeakPyramid.open(sidecar, sourceFile) is None
+    assert juce.AudioPeakPyramid.open(sidecar) is not None
+
+    pyramid = juce.AudioPeakPyramid.openOrBuild(manager, sourceFile)
+    assert juce.AudioPeakPyramid.open(sidecar, sourceFile) is not None
+    assert pyramid.getNumLevels() > 1
@@ -0,0 +1,93 @@
+import pytest
+import numpy as np
+
+import popsicle as juce
+
+from .utilities import write_wav_file
+
+#==================================================================================================
+
+def read_file(manager, path):
+    reader = manager.createReaderFor(juce.File(str(path)))
+    assert reader is not None
+    return reader.sampleRate, np.asarray(reader.readAll())
+
+@pytest.fixture
+def source_file(tmp_path):
+    phase = 2.0 * np.pi * 440.0 * np.arange(44100) / 44100.0
+    samples = (np.vstack([np.sin(phase), np.sin(phase)]) * 16384).astype(np.int16)
+    path = tmp_path / "source.wav"
+    write_wav_file(path, samples)
+    return path
+
+#==================================================================================================
+
+def test_transcode_rate_and_channels(manager, source_file, tmp_path):
+    jobs = [
+        juce.AudioTranscodeJob(juce.File(str(source_file)), juce.File(str(tmp_path / "mono.wav")), juce.WavAudioFormat(), numChannels=1),
+        juce.AudioTranscodeJob(juce.File(str(source_file)), juce.File(str(tmp_path / "resampled.wav")), juce.WavAudioFormat(), sampleRate=22050.0, bitsPerSample=24),
+        juce.AudioTranscodeJob(juce.File(str(tmp_path / "missing.wav")), juce.File(str(tmp_path / "never.wav")), juce.WavAudioFormat()),
+    ]
+
+    errors = juce.AudioTranscoder.transcode(manager, jobs, numThreads=2)
+    assert errors[0] == ""
+    assert errors[1] == ""
+    assert errors[2] != ""
+    assert not (tmp_path / "never.wav").exists()
+
+    sampleRate, samples = read_file(manager, tmp_path / "mono.wav")
+    assert sampleRate == 44100.0
+    assert samples.shape == (1, 44100)
+    assert np.allclose(samples[0], 0.5 * np.sin(2.0 * np.pi * 440.0 * np.arange(44100) / 44100.0), atol=1e-3)
+
+    sampleRate, samples = read_file(manager, tmp_path / "resampled.wav")
+    assert sampleRate == 22050.0
+    assert samples.shape == (2, 22050)
+    assert 0.4 < np.max(np.abs(samples[:, 100:-100])) < 0.6
+
+#==================================================================================================
+
+@pytest.mark.skipif(not hasattr(juce, "FlacAudioFormat"), reason="Flac support is not available")
+def test_transcode_async_to_flac(manager, source_file, tmp_path):
+    transcoder = juce.AudioTranscoder(manager, numThreads=1)
+    transcoder.start([juce.AudioTranscodeJob(juce.File(str(source_file)), juce.File(str(tmp_path / "out.flac")), juce.FlacAudioFormat())])
+
+    assert transcoder.getNumJobs() == 1
+    assert transcoder.waitForCompletion(10000)
+    assert not transcoder.isRunning()
+    assert transcoder.getProgress() == 1.0
+    assert transcoder.getErrors() == [""]
+
+    sampleRate, samples = read_file(manager, tmp_path / "out.flac")
+    assert samples.shape == (2, 44100)
+
+#==================================================================================================
+
+def test_transcode_cancel_leaves_no_output(manager, tmp_path):
+    samples = np.zeros((2, 44100 * 30), dtype=np.int16)
+    source = tmp_path / "long.wav"
+    write_wav_file(source, samples)
+
+    dest = tmp_path / "cancelled.wav"
+    transcoder = juce.AudioTranscoder(manager, numThreads=1, blockSize=64)
+    transcoder.start([juce.AudioTranscodeJob(juce.File(str(source)), juce.File(str(dest)), juce.WavAudioFormat(), sampleRate=48000.0)])
+    transcoder.cancel()
+
+    assert transcoder.waitForCompletion(30000)
+
+    # The job might have finished before the cancellation was seen, a partial file must never be left either way
+    errors = transcoder.getErrors()
+    if errors[0] == "":
+        assert read_file(manager, dest)[1].shape == (2, 48000 * 30)
+    else:
+        assert not dest.exists()
+
+    assert [path.name for path in tmp_path.iterdir() if path.name not in ("long.wav", "cancelled.wav")] == []
+
+#==================================================================================================
+
+def test_transcode_requires_format(manager, source_file, tmp_path):
+    transcoder = juce.AudioTranscoder(manager)
+
+    with pytest.raises(RuntimeError):
+        transcoder.start([juce.AudioTranscodeJob(juce.File(str(source_file)), juce.File(str(tmp_path / "out.wav")), None)])
@@ -0,0 +1,118 @@
+import math
+import pytest
+import struct
+import numpy as np
+
+import popsicle as juce
+
+from .utilities import write_wav_data
+
+#==================================================================================================
+
+def write_aiff_file(path, data, numChannels, sampleWidth, compressionType=None, sampleRate=44100):
+    mantissa, exponent = math.frexp(sampleRate)
+    rate = struct.pack(">HQ", exponent + 16382, int(mantissa * (1 << 64)))
+    numFrames = len(data) // (numChannels * sampleWidth)
+
+    comm = struct.pack(">hIh", numChannels, numFrames, sampleWidth * 8) + rate
+    if compressionType is not None:
+        comm += compressionType + b"\x00\x00"
+
+    chunks = b"COMM" + struct.pack(">I", len(comm)) + comm
+    chunks += b"SSND" + struct.pack(">III", len(data) + 8, 0, 0) + data
+
+    formType = b"AIFF" if compressionType is None else b"AIFC"
+    with open(str(path), "wb") as f:
+        f.write(b"FORM" + struct.pack(">I", len(chunks) + 4) + formType + chunks)
+
+def create_mapped_reader(path):
+    reader = juce.WavAudioFormat().createMemoryMappedReader(juce.File(str(path)))
+    assert reader is not None
+    return reader
+
+#==================================================================================================
+
+def test_mapped_view_int16(tmp_path):
+    samples = np.array([[0, 1000, -1000, 32767, 5], [1, 2, 3, 4, -32768]], dtype=np.int16)
+    path = tmp_path / "test16.wav"
+    write_wav_data(path, samples.T.astype("<i2").tobytes(), 2, 2)
+
+    reader = create_mapped_reader(path)
+    assert reader.mapEntireFile()
+
+    view = reader.getMappedSampleView()
+    assert view.getSampleFormat() == juce.MappedAudioSampleView.SampleFormat.int16
+    assert view.isLittleEndian()
+    assert view.getNumChannels() == 2
+    assert view.getNumSamples() == 5
+
+    array = np.asarray(view)
+    assert array.dtype == np.dtype("<i2")
+    assert array.shape == (2, 5)
+    assert not array.flags.writeable
+    assert np.array_equal(array, samples)
+
+    reader.touchSamples(0)
+    view.touch(1, 2)
+
+#==================================================================================================
+
+def test_mapped_view_section_outlives_reader(tmp_path):
+    samples = np.arange(1000, dtype=np.int16).reshape(1, -1)
+    path = tmp_path / "mono.wav"
+    write_wav_data(path, samples.T.astype("<i2").tobytes(), 1, 2)
+
+    reader = create_mapped_reader(path)
+    view = reader.createSampleView(100, 50)
+    del reader
+
+    assert view.getStartSample() == 100
+    assert np.array_equal(np.asarray(view)[0], samples[0, 100:150])
+
+    with pytest.raises(RuntimeError):
+        create_mapped_reader(path).createSampleView(2000)
+
+#==================================================================================================
+
+def test_mapped_view_packed_int24(tmp_path):
+    values = np.array([[0, 8388607, -8388608], [1, -1, 256]], dtype=np.int32)
+    packed = values.T.astype("<i4").view(np.uint8).reshape(3, 2, 4)[:, :, :3]
+    path = tmp_path / "test24.wav"
+    write_wav_data(path, packed.tobytes(), 2, 3)
+
+    view = create_mapped_reader(path).createSampleView()
+    assert view.isPacked24()
+
+    array = np.asarray(view)
+    assert array.dtype == np.uint8
+    assert array.shape == (2, 3, 3)
+
+    unpacked = (array[..., 0].astype(np.int32) | (array[..., 1].astype(np.int32) << 8) | (array[..., 2].astype(np.int32) << 16))
+    unpacked = np.where(unpacked >= 1 << 23, unpacked - (1 << 24), unpacked)
+    assert np.array_equal(unpacked, values)
+
+#==================================================================================================
+
+@pytest.mark.parametrize("compressionType,byteOrder", [(None, ">"), (b"NONE", ">"), (b"sowt", "<")])
+def test_mapped_view_aiff_byte_order(tmp_path, compressionType, byteOrder):
+    samples = np.array([[0, 1000, -1000, 32767], [1, 2, 3, -32768]], dtype=np.int16)
+    path = tmp_path / "test16.aif"
+    write_aiff_file(path, samples.T.astype(byteOrder + "i2").tobytes(), 2, 2, compressionType)
+
+    reader = juce.AiffAudioFormat().createMemoryMappedReader(juce.File(str(path)))
+    assert reader is not None
+
+    view = reader.createSampleView()
+    assert view.isLittleEndian() == (byteOrder == "<")
+    assert np.array_equal(np.asarray(view), samples)
+
+#==================================================================================================
+
+def test_mapped_view_silent_aiff_uses_declared_byte_order(tmp_path):
+    path = tmp_path / "silent.aif"
+    write_aiff_file(path, bytes(2 * 64), 1, 2, b"sowt")
+
+    reader = juce.AiffAudioFormat().createMemoryMappedReader(juce.File(str(path)))
+    view = reader.createSampleView()
+    assert view.isLittleEndian()
+    assert not np.asarray(view).any()
@@ -0,0 +1,25 @@
+import wave
+
+import popsicle as juce
+
+#==================================================================================================
+
+def write_wav_data(path, data, numChannels, sampleWidth, sampleRate=44100):
+    with wave.open(str(path), "wb") as f:
+        f.setnchannels(numChannels)
+        f.setsampwidth(sampleWidth)
+        f.setframerate(sampleRate)
+        f.writeframes(data)
+
+def write_wav_file(path, samples, sampleRate=44100):
+    write_wav_data(path, samples.T.astype("<i2").tobytes(), samples.shape[0], 2, sampleRate)
+
+#==================================================================================================
+
+def create_manager():
+    manager = juce.AudioFormatManager()
+    manager.registerBasicFormats()
+    return manager
+
+def create_reader(path):
+    return create_manager().createReaderFor(juce.File(str(path)))